@@ -24,16 +24,27 @@
 #                       the library needs it.
 
 list (APPEND MAIN_SOURCE_FILES
+	opm/geomech/AndersonAcceleration.cpp
+	opm/geomech/ClusterTree.cpp
 	opm/geomech/coupledsolver.cpp
 	opm/geomech/CutDe.cpp
+	opm/geomech/DenseLU.cpp
 	opm/geomech/DiscreteDisplacement.cpp
+	opm/geomech/FieldEvaluator.cpp
 	opm/geomech/FlexibleSolverMech.cpp
 	opm/geomech/Fracture_fullSystemIteration.cpp
 	opm/geomech/Fracture.cpp
+	opm/geomech/FractureDistribution.cpp
+	opm/geomech/FractureGeometryCache.cpp
 	opm/geomech/FractureModel.cpp
+	opm/geomech/FractureInteraction.cpp
+	opm/geomech/FracturePressureSolver.cpp
+	opm/geomech/FractureSettings.cpp
 	opm/geomech/FractureWell.cpp
 	opm/geomech/GeometryHelpers.cpp
 	opm/geomech/GridStretcher.cpp
+	opm/geomech/HMatrix.cpp
+	opm/geomech/LatticeOperator.cpp
 	opm/geomech/param_interior.cpp
 	opm/geomech/RegularTrimesh.cpp
 	opm/geomech/vem/vem.cpp
@@ -47,12 +58,15 @@ list (APPEND PROGRAM_SOURCE_FILES
 )
 
 list (APPEND PUBLIC_HEADER_FILES
+	opm/geomech/AndersonAcceleration.hpp
 	opm/geomech/BlackoilGeomechWellModel.hpp
 	opm/geomech/BlackoilModelGeomech.hpp
 	opm/geomech/boundaryutils.hh
+	opm/geomech/ClusterTree.hpp
 	opm/geomech/convex_boundary.hpp
 	opm/geomech/coupledsolver.hpp
 	opm/geomech/CutDe.hpp
+	opm/geomech/DenseLU.hpp
 	opm/geomech/DiscreteDisplacement.hpp
 	opm/geomech/DuneCommunicationHelpers.hpp
 	opm/geomech/dune_utilities.hpp
@@ -60,15 +74,24 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/geomech/eclproblemgeomech.hh
 	opm/geomech/elasticity_solver.hpp
 	opm/geomech/elasticity_solver_impl.hpp
+	opm/geomech/FieldEvaluator.hpp
 	opm/geomech/FlowGeomechLinearSolverParameters.hpp
 	opm/geomech/Fracture.hpp
 	opm/geomech/Fracture_impl.hpp
+	opm/geomech/FractureDistribution.hpp
+	opm/geomech/FractureGeometryCache.hpp
 	opm/geomech/FractureModel.hpp
 	opm/geomech/FractureModel_impl.hpp
+	opm/geomech/FractureInteraction.hpp
+	opm/geomech/FracturePressureSolver.hpp
+	opm/geomech/FractureSettings.hpp
 	opm/geomech/FractureWell.hpp
 	opm/geomech/GeometryHelpers.hpp
 	opm/geomech/GridStretcher.hpp
+	opm/geomech/HMatrix.hpp
+	opm/geomech/LatticeOperator.hpp
 	opm/geomech/Math.hpp
+	opm/geomech/MatrixFreeOperator.hpp
 	opm/geomech/param_interior.hpp
 	opm/geomech/RegularTrimesh.hpp
 	opm/geomech/vem_elasticity_solver.hpp
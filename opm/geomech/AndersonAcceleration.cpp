@@ -0,0 +1,146 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/AndersonAcceleration.hpp>
+
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+double
+dot(const std::vector<double>& a, const std::vector<double>& b)
+{
+    double sum = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+} // anonymous namespace
+
+namespace Opm
+{
+AndersonAcceleration::AndersonAcceleration(const std::size_t depth)
+    : depth_(depth)
+{
+}
+
+void
+AndersonAcceleration::reset()
+{
+    df_.clear();
+    dg_.clear();
+    f_prev_.clear();
+    g_prev_.clear();
+}
+
+void
+AndersonAcceleration::update(const std::vector<double>& x,
+                             const std::vector<double>& gx,
+                             std::vector<double>& x_next)
+{
+    assert(x.size() == gx.size());
+    const std::size_t n = x.size();
+
+    std::vector<double> f(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        f[i] = gx[i] - x[i];
+    }
+
+    if (depth_ > 0 && f_prev_.size() == n) {
+        std::vector<double> df(n), dg(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            df[i] = f[i] - f_prev_[i];
+            dg[i] = gx[i] - g_prev_[i];
+        }
+        df_.push_back(std::move(df));
+        dg_.push_back(std::move(dg));
+        if (df_.size() > depth_) {
+            df_.pop_front();
+            dg_.pop_front();
+        }
+    }
+    f_prev_ = f;
+    g_prev_ = gx;
+
+    x_next = gx;
+    const std::size_t m = df_.size();
+    if (m == 0) {
+        return;
+    }
+
+    // modified Gram-Schmidt QR of the residual differences; a column whose
+    // remaining part is negligible compared to its norm is skipped
+    std::vector<std::vector<double>> q;
+    std::vector<std::vector<double>> r(m, std::vector<double>(m, 0.0));
+    std::vector<std::size_t> cols;
+    for (std::size_t j = 0; j < m; ++j) {
+        std::vector<double> v = df_[j];
+        const double norm0 = std::sqrt(dot(v, v));
+        for (std::size_t k = 0; k < q.size(); ++k) {
+            const double rkj = dot(q[k], v);
+            r[k][cols.size()] = rkj;
+            for (std::size_t i = 0; i < n; ++i) {
+                v[i] -= rkj * q[k][i];
+            }
+        }
+        const double norm = std::sqrt(dot(v, v));
+        if (!(norm > 1e-10 * norm0)) {
+            continue;
+        }
+        for (auto& vi : v) {
+            vi /= norm;
+        }
+        r[q.size()][cols.size()] = norm;
+        q.push_back(std::move(v));
+        cols.push_back(j);
+    }
+
+    // gamma = R^-1 Q^T f
+    const std::size_t k = cols.size();
+    std::vector<double> gamma(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        gamma[i] = dot(q[i], f);
+    }
+    for (std::size_t i = k; i-- > 0;) {
+        for (std::size_t j = i + 1; j < k; ++j) {
+            gamma[i] -= r[i][j] * gamma[j];
+        }
+        gamma[i] /= r[i][i];
+    }
+
+    for (std::size_t c = 0; c < k; ++c) {
+        const auto& dg = dg_[cols[c]];
+        for (std::size_t i = 0; i < n; ++i) {
+            x_next[i] -= gamma[c] * dg[i];
+        }
+    }
+
+    for (const double v : x_next) {
+        if (!std::isfinite(v)) {
+            x_next = gx; // fall back to the plain fixed-point step
+            return;
+        }
+    }
+}
+
+} // namespace Opm
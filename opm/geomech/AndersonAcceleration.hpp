@@ -0,0 +1,65 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ANDERSON_ACCELERATION_HPP_INCLUDED
+#define OPM_ANDERSON_ACCELERATION_HPP_INCLUDED
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace Opm
+{
+// Anderson acceleration of a fixed-point iteration x = G(x).  Given the current
+// iterate x_k and its image G(x_k), the next iterate is the combination of the
+// latest 'depth' images whose residual f = G(x) - x has the smallest norm
+// (Walker & Ni, SIAM J. Numer. Anal. 49 (2011)).  The least-squares problem is
+// solved by a QR factorization of the residual differences, where (nearly)
+// linearly dependent differences are skipped.  With depth 0 the iteration
+// reduces to the plain Picard iteration x_{k+1} = G(x_k).
+class AndersonAcceleration
+{
+public:
+    explicit AndersonAcceleration(std::size_t depth);
+
+    std::size_t depth() const
+    {
+        return depth_;
+    }
+
+    // Computes the next iterate 'x_next' from 'x' and 'gx' = G(x).  All vectors
+    // must have the same size as in the previous calls since the last reset().
+    void update(const std::vector<double>& x,
+                const std::vector<double>& gx,
+                std::vector<double>& x_next);
+
+    // forget the history (e.g. when the size of the unknowns changes)
+    void reset();
+
+private:
+    std::size_t depth_;
+    std::deque<std::vector<double>> df_; // differences of consecutive residuals
+    std::deque<std::vector<double>> dg_; // differences of consecutive images
+    std::vector<double> f_prev_;
+    std::vector<double> g_prev_;
+};
+
+} // namespace Opm
+
+#endif // OPM_ANDERSON_ACCELERATION_HPP_INCLUDED
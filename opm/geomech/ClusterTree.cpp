@@ -0,0 +1,126 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/ClusterTree.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+using ddm::BoxPoint;
+using ddm::Cluster;
+
+int
+buildCluster(const std::vector<BoxPoint>& lo,
+             const std::vector<BoxPoint>& hi,
+             std::vector<std::size_t>& perm,
+             std::vector<Cluster>& tree,
+             const std::size_t begin,
+             const std::size_t end,
+             const std::size_t leaf_size,
+             const int parent)
+{
+    const int idx = static_cast<int>(tree.size());
+    tree.emplace_back();
+
+    Cluster cluster;
+    cluster.begin = begin;
+    cluster.end = end;
+    cluster.parent = parent;
+    cluster.lo.fill(std::numeric_limits<double>::max());
+    cluster.hi.fill(std::numeric_limits<double>::lowest());
+
+    for (std::size_t i = begin; i != end; ++i) {
+        for (int dim = 0; dim != 3; ++dim) {
+            cluster.lo[dim] = std::min(cluster.lo[dim], lo[perm[i]][dim]);
+            cluster.hi[dim] = std::max(cluster.hi[dim], hi[perm[i]][dim]);
+        }
+    }
+
+    if (end - begin > leaf_size) {
+        // split in two halves along the largest extent of the bounding box
+        int split_dim = 0;
+        for (int dim = 1; dim != 3; ++dim) {
+            if (cluster.hi[dim] - cluster.lo[dim] > cluster.hi[split_dim] - cluster.lo[split_dim]) {
+                split_dim = dim;
+            }
+        }
+
+        const std::size_t mid = begin + (end - begin) / 2;
+        std::nth_element(perm.begin() + begin,
+                         perm.begin() + mid,
+                         perm.begin() + end,
+                         [&lo, &hi, split_dim](const std::size_t a, const std::size_t b) {
+                             return lo[a][split_dim] + hi[a][split_dim]
+                                 < lo[b][split_dim] + hi[b][split_dim];
+                         });
+
+        cluster.child[0] = buildCluster(lo, hi, perm, tree, begin, mid, leaf_size, idx);
+        cluster.child[1] = buildCluster(lo, hi, perm, tree, mid, end, leaf_size, idx);
+    }
+
+    tree[idx] = cluster;
+    return idx;
+}
+} // namespace
+
+namespace ddm
+{
+void
+buildClusterTree(const std::vector<BoxPoint>& lo,
+                 const std::vector<BoxPoint>& hi,
+                 const std::size_t leaf_size,
+                 std::vector<std::size_t>& perm,
+                 std::vector<Cluster>& tree)
+{
+    perm.resize(lo.size());
+    std::iota(perm.begin(), perm.end(), std::size_t {0});
+    tree.clear();
+
+    if (!lo.empty()) {
+        buildCluster(lo, hi, perm, tree, 0, lo.size(), leaf_size, -1);
+    }
+}
+
+double
+boxDiameter(const BoxPoint& lo, const BoxPoint& hi)
+{
+    return std::hypot(hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]);
+}
+
+double
+boxDistance(const BoxPoint& lo1, const BoxPoint& hi1, const BoxPoint& lo2, const BoxPoint& hi2)
+{
+    double d2 = 0.0;
+    for (int dim = 0; dim != 3; ++dim) {
+        const double gap = std::max({0.0, lo1[dim] - hi2[dim], lo2[dim] - hi1[dim]});
+        d2 += gap * gap;
+    }
+
+    return std::sqrt(d2);
+}
+
+} // namespace ddm
@@ -0,0 +1,61 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CLUSTER_TREE_HPP_INCLUDED
+#define OPM_CLUSTER_TREE_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace ddm
+{
+// Cluster tree by recursive bisection, shared by the hierarchical approximations
+// (HMatrix and FieldEvaluator).  Items have axis-aligned bounding boxes, with
+// lo == hi for points.
+using BoxPoint = std::array<double, 3>;
+
+struct Cluster
+{
+    std::size_t begin {}; // range in the permutation vector
+    std::size_t end {};
+    BoxPoint lo {};
+    BoxPoint hi {};
+    std::array<int, 2> child {-1, -1};
+    int parent {-1};
+};
+
+// Cluster tree of the items with boxes [lo[i], hi[i]], with the root as tree[0].  A
+// cluster is split in two halves, at the median of the box centers along the largest
+// extent of its bounding box, if it has more than 'leaf_size' items.  The items of
+// cluster c are perm[c.begin], ..., perm[c.end - 1].
+void buildClusterTree(const std::vector<BoxPoint>& lo,
+                      const std::vector<BoxPoint>& hi,
+                      std::size_t leaf_size,
+                      std::vector<std::size_t>& perm,
+                      std::vector<Cluster>& tree);
+
+double boxDiameter(const BoxPoint& lo, const BoxPoint& hi);
+
+// distance between two axis-aligned bounding boxes (0 if they overlap)
+double boxDistance(const BoxPoint& lo1, const BoxPoint& hi1, const BoxPoint& lo2, const BoxPoint& hi2);
+
+} // namespace ddm
+
+#endif // OPM_CLUSTER_TREE_HPP_INCLUDED
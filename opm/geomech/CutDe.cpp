@@ -66,7 +66,13 @@ Only the interface code is modified to easier call it from c++
 #include <array>
 #include <cmath>
 
-#define WITHIN_KERNEL /*;*/
+// Kernel functions are forcibly inlined, so that the loops over observation
+// points in the batched functions can be vectorized
+#if defined(__GNUC__)
+#define WITHIN_KERNEL inline __attribute__((always_inline))
+#else
+#define WITHIN_KERNEL inline
+#endif
 
 #ifndef M_PI
 #define M_PI (3.14159265358979323846264338327950288)
@@ -252,34 +258,31 @@ trimodefinder(const ddm::Real3& obs,
 
     const auto c = 1 - a - b;
 
-    int result = 1;
-    if ((a <= 0 && b > c && c > a) || (b <= 0 && c > a && a > b) || (c <= 0 && a > b && b > c)) {
-        result = -1;
-    }
+    // NB: conditions are combined with bitwise operators (no short-circuiting)
+    // so that this can be evaluated without branches in vectorized loops
+    const bool second = ((a <= 0) & (b > c) & (c > a)) | ((b <= 0) & (c > a) & (a > b))
+        | ((c <= 0) & (a > b) & (b > c));
 
-    if ((a == 0 && b >= 0 && c >= 0) || (a >= 0 && b == 0 && c >= 0) || (a >= 0 && b >= 0 && c == 0)) {
-        result = 0;
-    }
+    const bool on_side = ((a == 0) & (b >= 0) & (c >= 0)) | ((a >= 0) & (b == 0) & (c >= 0))
+        | ((a >= 0) & (b >= 0) & (c == 0));
 
-    if (result == 0 && obs.x != 0) {
-        result = 1;
-    }
+    const int result = second ? -1 : 1;
 
-    return result;
+    return (on_side & (obs.x == 0)) ? 0 : (on_side ? 1 : result);
 }
 
 WITHIN_KERNEL ddm::Real3
 AngDisDisp(const ddm::Real x,
            const ddm::Real y,
            const ddm::Real z,
-           const ddm::Real alpha,
+           const ddm::Real cosA,
+           const ddm::Real sinA,
            const ddm::Real bx,
            const ddm::Real by,
            const ddm::Real bz,
            const ddm::Real nu)
 {
-    const auto cosA = std::cos(alpha);
-    const auto sinA = std::sin(alpha);
+    // 'cosA' and 'sinA' are the cosine and sine of the angle of the angular dislocation
     const auto eta = y * cosA - z * sinA;
     const auto zeta = y * sinA + z * cosA;
     const auto r = std::hypot(x, y, z);
@@ -314,7 +317,8 @@ AngDisDisp(const ddm::Real x,
 
 WITHIN_KERNEL ddm::Real3
 TDSetupD(const ddm::Real3& obs,
-         const ddm::Real alpha,
+         const ddm::Real cosA,
+         const ddm::Real sinA,
          const ddm::Real3& slip,
          const ddm::Real nu,
          const ddm::Real3& TriVertex,
@@ -335,7 +339,7 @@ TDSetupD(const ddm::Real3& obs,
     const auto by1 = r2.x;
     const auto bz1 = r2.y;
 
-    const auto uvw = AngDisDisp(obs.x, y1, z1, -M_PI + alpha, slip.x, by1, bz1, nu);
+    const auto uvw = AngDisDisp(obs.x, y1, z1, cosA, sinA, slip.x, by1, bz1, nu);
 
     const auto r3 = inv_transform2(A1, A2, make2(uvw.y, uvw.z));
     const auto v = r3.x;
@@ -348,17 +352,17 @@ WITHIN_KERNEL ddm::Real6
 AngDisStrain(const ddm::Real x,
              const ddm::Real y,
              const ddm::Real z,
-             const ddm::Real alpha,
+             const ddm::Real cosA,
+             const ddm::Real sinA,
              const ddm::Real bx,
              const ddm::Real by,
              const ddm::Real bz,
              const ddm::Real nu)
 {
     // AngDisStrain calculates the strains associated with an angular
-    // dislocation in an elastic full-space.
+    // dislocation in an elastic full-space.  'cosA' and 'sinA' are the cosine
+    // and sine of the angle of the dislocation.
 
-    const auto cosA = std::cos(alpha);
-    const auto sinA = std::sin(alpha);
     const auto eta = y * cosA - z * sinA;
     const auto zeta = y * sinA + z * cosA;
 
@@ -443,7 +447,8 @@ AngDisStrain(const ddm::Real x,
 
 WITHIN_KERNEL ddm::Real6
 TDSetupS(const ddm::Real3& obs,
-         const ddm::Real alpha,
+         const ddm::Real cosA,
+         const ddm::Real sinA,
          const ddm::Real3& slip,
          const ddm::Real nu,
          const ddm::Real3& TriVertex,
@@ -468,7 +473,7 @@ TDSetupS(const ddm::Real3& obs,
     const auto bz1 = r2.y;
 
     // Calculate strains associated with an angular dislocation in ADCS
-    const auto out_adcs = AngDisStrain(obs.x, y1, z1, -M_PI + alpha, slip.x, by1, bz1, nu);
+    const auto out_adcs = AngDisStrain(obs.x, y1, z1, cosA, sinA, slip.x, by1, bz1, nu);
 
     // Transform strains from ADCS into TDCS
     const auto B0 = ddm::make3(1.0, 0.0, 0.0);
@@ -478,26 +483,31 @@ TDSetupS(const ddm::Real3& obs,
     return tensor_transform3(B0, B1, B2, out_adcs);
 }
 
-// only used for haspace
-void
-setup_tde(ddm::Real3& transformed_obs,
-          std::array<ddm::Real3, 3>& transformed_tri,
-          ddm::Real& A,
-          ddm::Real& B,
-          ddm::Real& C,
-          ddm::Real3& e12,
-          ddm::Real3& e13,
-          ddm::Real3& e23,
-          ddm::Real3& Vnorm,
-          ddm::Real3& Vstrike,
-          ddm::Real3& Vdip,
-          int& mode,
-          const ddm::Real3& obs,
-          const std::array<ddm::Real3, 3>& tri_prefix,
-          const ddm::Real3& slip,
-          const ddm::Real& nu,
-          const bool is_halfspace)
+// Triangle dependent part of the setup, shared by all observation points
+struct TriangleFrame
 {
+    std::array<ddm::Real3, 3> transformed_tri;
+    ddm::Real3 e12, e13, e23;
+    ddm::Real3 Vnorm, Vstrike, Vdip;
+
+    // cosine and sine of the angles of the three angular dislocations (-pi + A,
+    // -pi + B and -pi + C)
+    std::array<ddm::Real, 3> cosA, sinA;
+};
+
+TriangleFrame
+setup_triangle(const std::array<ddm::Real3, 3>& tri_prefix, const bool is_halfspace)
+{
+    TriangleFrame frame;
+
+    auto& transformed_tri = frame.transformed_tri;
+    auto& e12 = frame.e12;
+    auto& e13 = frame.e13;
+    auto& e23 = frame.e23;
+    auto& Vnorm = frame.Vnorm;
+    auto& Vstrike = frame.Vstrike;
+    auto& Vdip = frame.Vdip;
+
     // printf("is_halfspace: %s\n", ${is_halfspace} ? "true":"false");
     // Real3
     Vnorm = normalize3(cross3(sub3(tri_prefix[1], tri_prefix[0]), sub3(tri_prefix[2], tri_prefix[0])));
@@ -523,9 +533,6 @@ setup_tde(ddm::Real3& transformed_obs,
     // Real3
     Vdip = cross3(Vnorm, Vstrike);
 
-    // Real3
-    transformed_obs = transform3(Vnorm, Vstrike, Vdip, sub3(obs, tri_prefix[1]));
-
     // Real3
     transformed_tri[0] = transform3(Vnorm, Vstrike, Vdip, sub3(tri_prefix[0], tri_prefix[1]));
 
@@ -539,79 +546,98 @@ setup_tde(ddm::Real3& transformed_obs,
     e13 = normalize3(sub3(transformed_tri[2], transformed_tri[0]));
     e23 = normalize3(sub3(transformed_tri[2], transformed_tri[1]));
 
-    A = std::acos(dot3(e12, e13));
-    B = std::acos(dot3(negate3(e12), e23));
-    C = std::acos(dot3(e23, e13));
+    const std::array<ddm::Real, 3> angles {std::acos(dot3(e12, e13)), // A
+                                           std::acos(dot3(negate3(e12), e23)), // B
+                                           std::acos(dot3(e23, e13))}; // C
+
+    for (int k = 0; k != 3; ++k) {
+        frame.cosA[k] = std::cos(-M_PI + angles[k]);
+        frame.sinA[k] = std::sin(-M_PI + angles[k]);
+    }
 
-    mode = trimodefinder(transformed_obs, transformed_tri[0], transformed_tri[1], transformed_tri[2]);
+    return frame;
 }
 
-} // Anonymous namespace
+// Observation point dependent part of the setup: coordinates in TDCS and the
+// configuration of the angular dislocations (see trimodefinder)
+WITHIN_KERNEL void
+setup_obs(ddm::Real3& transformed_obs,
+          int& mode,
+          const ddm::Real3& obs,
+          const TriangleFrame& frame,
+          const ddm::Real3& tri1)
+{
+    transformed_obs = transform3(frame.Vnorm, frame.Vstrike, frame.Vdip, sub3(obs, tri1));
 
-ddm::Real3
-ddm::disp_fs(const Real3& obs, const std::array<Real3, 3>& tri, const Real3& slip, const Real nu)
+    mode = trimodefinder(transformed_obs,
+                         frame.transformed_tri[0],
+                         frame.transformed_tri[1],
+                         frame.transformed_tri[2]);
+}
+
+// Side vectors of the three angular dislocations in the first configuration
+// (mode 1).  In the second configuration (mode -1) they are all reversed.
+std::array<ddm::Real3, 3>
+side_vectors(const TriangleFrame& frame)
 {
-    Real3 transformed_obs;
-    std::array<Real3, 3> transformed_tri;
-    Real A, B, C;
-    Real3 e12, e13, e23;
-    Real3 Vnorm, Vstrike, Vdip;
-    int mode;
+    return {negate3(frame.e13), frame.e12, frame.e23};
+}
 
-    setup_tde(transformed_obs,
-              transformed_tri,
-              A,
-              B,
-              C,
-              e12,
-              e13,
-              e23,
-              Vnorm,
-              Vstrike,
-              Vdip,
-              mode,
-              obs,
-              tri,
-              slip,
-              nu,
-              /*is_halfspace*/ false);
-
-    Real3 out {};
-    if (mode == 1) {
-        // Calculate first angular dislocation contribution
-        const auto r1Tp = TDSetupD(transformed_obs, A, slip, nu, transformed_tri[0], negate3(e13));
-
-        // Calculate second angular dislocation contribution
-        const auto r2Tp = TDSetupD(transformed_obs, B, slip, nu, transformed_tri[1], e12);
-
-        // Calculate third angular dislocation contribution
-        const auto r3Tp = TDSetupD(transformed_obs, C, slip, nu, transformed_tri[2], e23);
-
-        out = add3(add3(r1Tp, r2Tp), r3Tp);
-    } else if (mode == -1) {
-        // Calculate first angular dislocation contribution
-        const auto r1Tn = TDSetupD(transformed_obs, A, slip, nu, transformed_tri[0], e13);
-
-        // Calculate second angular dislocation contribution
-        const auto r2Tn = TDSetupD(transformed_obs, B, slip, nu, transformed_tri[1], negate3(e12));
-
-        // Calculate third angular dislocation contribution
-        const auto r3Tn = TDSetupD(transformed_obs, C, slip, nu, transformed_tri[2], negate3(e23));
-
-        out = add3(add3(r1Tn, r2Tn), r3Tn);
-    } else {
-        out = make3(NAN, NAN, NAN);
-    }
+// displacement (in TDCS) at one observation point, without the contribution
+// of the solid angle
+WITHIN_KERNEL ddm::Real3
+disp_tdcs(const ddm::Real3& transformed_obs,
+          const int mode,
+          const TriangleFrame& frame,
+          const std::array<ddm::Real3, 3>& sides,
+          const ddm::Real3& slip,
+          const ddm::Real nu)
+{
+    // branch-free selection of the configuration
+    const ddm::Real sign = (mode == -1) ? -1.0 : 1.0;
+
+    // (written out rather than looping, to keep the enclosing loop vectorizable)
+    const auto comp1 = TDSetupD(transformed_obs,
+                                frame.cosA[0],
+                                frame.sinA[0],
+                                slip,
+                                nu,
+                                frame.transformed_tri[0],
+                                mul_scalar3(sides[0], sign));
+    const auto comp2 = TDSetupD(transformed_obs,
+                                frame.cosA[1],
+                                frame.sinA[1],
+                                slip,
+                                nu,
+                                frame.transformed_tri[1],
+                                mul_scalar3(sides[1], sign));
+    const auto comp3 = TDSetupD(transformed_obs,
+                                frame.cosA[2],
+                                frame.sinA[2],
+                                slip,
+                                nu,
+                                frame.transformed_tri[2],
+                                mul_scalar3(sides[2], sign));
+
+    const auto out = add3(add3(comp1, comp2), comp3);
+
+    return (mode == 0) ? ddm::make3(NAN, NAN, NAN) : out;
+}
+
+WITHIN_KERNEL ddm::Real
+solid_angle_term(const ddm::Real3& transformed_obs, const TriangleFrame& frame)
+{
+    const auto& transformed_tri = frame.transformed_tri;
 
-    const auto a = make3(-transformed_obs.x,
-                         transformed_tri[0].y - transformed_obs.y,
-                         transformed_tri[0].z - transformed_obs.z);
+    const auto a = ddm::make3(-transformed_obs.x,
+                              transformed_tri[0].y - transformed_obs.y,
+                              transformed_tri[0].z - transformed_obs.z);
 
     const auto b = negate3(transformed_obs);
 
-    const auto c = make3(-transformed_obs.x,
-                         transformed_tri[2].y - transformed_obs.y,
-                         transformed_tri[2].z - transformed_obs.z);
+    const auto c = ddm::make3(-transformed_obs.x,
+                              transformed_tri[2].y - transformed_obs.y,
+                              transformed_tri[2].z - transformed_obs.z);
 
     const auto na = length3(a);
     const auto nb = length3(b);
@@ -621,67 +647,160 @@ ddm::disp_fs(const Real3& obs, const std::array<Real3, 3>& tri, const Real3& sli
         = a.x * (b.y * c.z - b.z * c.y) - a.y * (b.x * c.z - b.z * c.x) + a.z * (b.x * c.y - b.y * c.x);
 
     const auto FiD = na * nb * nc + dot3(a, b) * nc + dot3(a, c) * nb + dot3(b, c) * na;
-    const auto Fi = -2 * std::atan2(FiN, FiD) / (4 / M_PI);
+
+    return -2 * std::atan2(FiN, FiD) / (4 / M_PI);
+}
+
+// strain (in EFCS) at one observation point
+WITHIN_KERNEL ddm::Real6
+strain_efcs(const ddm::Real3& transformed_obs,
+            const int mode,
+            const TriangleFrame& frame,
+            const std::array<ddm::Real3, 3>& sides,
+            const ddm::Real3& slip,
+            const ddm::Real nu)
+{
+    // branch-free selection of the configuration
+    const ddm::Real sign = (mode == -1) ? -1.0 : 1.0;
+
+    // (written out rather than looping, to keep the enclosing loop vectorizable)
+    const auto comp1 = TDSetupS(transformed_obs,
+                                frame.cosA[0],
+                                frame.sinA[0],
+                                slip,
+                                nu,
+                                frame.transformed_tri[0],
+                                mul_scalar3(sides[0], sign));
+    const auto comp2 = TDSetupS(transformed_obs,
+                                frame.cosA[1],
+                                frame.sinA[1],
+                                slip,
+                                nu,
+                                frame.transformed_tri[1],
+                                mul_scalar3(sides[1], sign));
+    const auto comp3 = TDSetupS(transformed_obs,
+                                frame.cosA[2],
+                                frame.sinA[2],
+                                slip,
+                                nu,
+                                frame.transformed_tri[2],
+                                mul_scalar3(sides[2], sign));
+
+    const auto out = (mode == 0) ? ddm::make6(NAN, NAN, NAN, NAN, NAN, NAN)
+                                 : add6(add6(comp1, comp2), comp3);
+
+    return tensor_transform3(frame.Vnorm, frame.Vstrike, frame.Vdip, out);
+}
+
+} // Anonymous namespace
+
+ddm::Real3
+ddm::disp_fs(const Real3& obs, const std::array<Real3, 3>& tri, const Real3& slip, const Real nu)
+{
+    const TriangleFrame frame = setup_triangle(tri, /*is_halfspace*/ false);
+    const auto sides = side_vectors(frame);
+
+    Real3 transformed_obs;
+    int mode;
+    setup_obs(transformed_obs, mode, obs, frame, tri[1]);
 
     // Calculate the complete displacement vector components in TDCS
-    out = add3(out, mul_scalar3(slip, Fi));
+    const Real3 out = add3(disp_tdcs(transformed_obs, mode, frame, sides, slip, nu),
+                           mul_scalar3(slip, solid_angle_term(transformed_obs, frame)));
 
     // Transform the complete displacement vector components from TDCS into EFCS
-    return inv_transform3(Vnorm, Vstrike, Vdip, out);
+    return inv_transform3(frame.Vnorm, frame.Vstrike, frame.Vdip, out);
 }
 
 ddm::Real6
 ddm::strain_fs(const Real3& obs, const std::array<Real3, 3>& tri, const Real3& slip, const Real nu)
 {
+    const TriangleFrame frame = setup_triangle(tri, /*is_halfspace*/ false);
+    const auto sides = side_vectors(frame);
+
     Real3 transformed_obs;
-    std::array<Real3, 3> transformed_tri;
-    Real A, B, C;
-    Real3 e12, e13, e23;
-    Real3 Vnorm, Vstrike, Vdip;
     int mode;
+    setup_obs(transformed_obs, mode, obs, frame, tri[1]);
+
+    return strain_efcs(transformed_obs, mode, frame, sides, slip, nu);
+}
+
+void
+ddm::disp_fs(const Real3Array& obs,
+             const std::array<Real3, 3>& tri,
+             const Real3& slip,
+             const Real nu,
+             Real3Array& out)
+{
+    const TriangleFrame frame = setup_triangle(tri, /*is_halfspace*/ false);
+    const auto sides = side_vectors(frame);
 
-    setup_tde(transformed_obs,
-              transformed_tri,
-              A,
-              B,
-              C,
-              e12,
-              e13,
-              e23,
-              Vnorm,
-              Vstrike,
-              Vdip,
-              mode,
-              obs,
-              tri,
-              slip,
-              nu,
-              /*is_halfspace*/ false);
-
-    Real6 out;
-    if (mode == 1) {
-        // Calculate first angular dislocation contribution
-        Real6 comp1 = TDSetupS(transformed_obs, A, slip, nu, transformed_tri[0], negate3(e13));
-        // Calculate second angular dislocation contribution
-        Real6 comp2 = TDSetupS(transformed_obs, B, slip, nu, transformed_tri[1], e12);
-        // Calculate third angular dislocation contribution
-        Real6 comp3 = TDSetupS(transformed_obs, C, slip, nu, transformed_tri[2], e23);
-
-        out = add6(add6(comp1, comp2), comp3);
-    } else if (mode == -1) {
-        // Calculate first angular dislocation contribution
-        const Real6 comp1 = TDSetupS(transformed_obs, A, slip, nu, transformed_tri[0], e13);
-
-        // Calculate second angular dislocation contribution
-        const Real6 comp2 = TDSetupS(transformed_obs, B, slip, nu, transformed_tri[1], negate3(e12));
-
-        // Calculate third angular dislocation contribution
-        const Real6 comp3 = TDSetupS(transformed_obs, C, slip, nu, transformed_tri[2], negate3(e23));
-
-        out = add6(add6(comp1, comp2), comp3);
-    } else {
-        out = make6(NAN, NAN, NAN, NAN, NAN, NAN);
+    const std::size_t n = obs.size();
+    out.resize(n);
+
+    const Real* const ox = obs.x.data();
+    const Real* const oy = obs.y.data();
+    const Real* const oz = obs.z.data();
+    Real* const ux = out.x.data();
+    Real* const uy = out.y.data();
+    Real* const uz = out.z.data();
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        Real3 transformed_obs;
+        int mode;
+        setup_obs(transformed_obs, mode, make3(ox[i], oy[i], oz[i]), frame, tri[1]);
+
+        const Real3 u = add3(disp_tdcs(transformed_obs, mode, frame, sides, slip, nu),
+                             mul_scalar3(slip, solid_angle_term(transformed_obs, frame)));
+        const Real3 res = inv_transform3(frame.Vnorm, frame.Vstrike, frame.Vdip, u);
+
+        ux[i] = res.x;
+        uy[i] = res.y;
+        uz[i] = res.z;
     }
+}
 
-    return tensor_transform3(Vnorm, Vstrike, Vdip, out);
+void
+ddm::strain_fs(const Real3Array& obs,
+               const std::array<Real3, 3>& tri,
+               const Real3& slip,
+               const Real nu,
+               Real6Array& out)
+{
+    const TriangleFrame frame = setup_triangle(tri, /*is_halfspace*/ false);
+    const auto sides = side_vectors(frame);
+
+    const std::size_t n = obs.size();
+    out.resize(n);
+
+    const Real* const ox = obs.x.data();
+    const Real* const oy = obs.y.data();
+    const Real* const oz = obs.z.data();
+    Real* const sx = out.x.data();
+    Real* const sy = out.y.data();
+    Real* const sz = out.z.data();
+    Real* const sa = out.a.data();
+    Real* const sb = out.b.data();
+    Real* const sc = out.c.data();
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        Real3 transformed_obs;
+        int mode;
+        setup_obs(transformed_obs, mode, make3(ox[i], oy[i], oz[i]), frame, tri[1]);
+
+        const Real6 res = strain_efcs(transformed_obs, mode, frame, sides, slip, nu);
+
+        sx[i] = res.x;
+        sy[i] = res.y;
+        sz[i] = res.z;
+        sa[i] = res.a;
+        sb[i] = res.b;
+        sc[i] = res.c;
+    }
 }
@@ -21,6 +21,8 @@
 #define OPM_CUTDE_HPP_INCLUDED
 
 #include <array>
+#include <cstddef>
+#include <vector>
 
 namespace ddm
 {
@@ -49,11 +51,66 @@ struct Real6
     Real c {};
 };
 
+// Structure-of-arrays storage of many points or vectors
+struct Real3Array
+{
+    std::vector<Real> x, y, z;
+
+    std::size_t size() const
+    {
+        return x.size();
+    }
+
+    void resize(const std::size_t n)
+    {
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+    }
+};
+
+// Structure-of-arrays storage of many symmetric tensors (same component order as Real6)
+struct Real6Array
+{
+    std::vector<Real> x, y, z, a, b, c;
+
+    std::size_t size() const
+    {
+        return x.size();
+    }
+
+    void resize(const std::size_t n)
+    {
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+        a.resize(n);
+        b.resize(n);
+        c.resize(n);
+    }
+};
+
 Real3 make3(Real x, Real y, Real z);
 Real6 make6(Real x, Real y, Real z, Real a, Real b, Real c);
 Real3 disp_fs(const Real3& obs, const std::array<Real3, 3>& tri, const Real3& slip, Real nu);
 Real6 strain_fs(const Real3& obs, const std::array<Real3, 3>& tri, const Real3& slip, Real nu);
 
+// Batched versions, evaluating the field of one triangle at all the points in
+// 'obs'.  The triangle setup is done once, and the loop over the points is
+// branch-free so that it can be vectorized (OpenMP SIMD).  'out' is resized
+// to obs.size().
+void disp_fs(const Real3Array& obs,
+             const std::array<Real3, 3>& tri,
+             const Real3& slip,
+             Real nu,
+             Real3Array& out);
+
+void strain_fs(const Real3Array& obs,
+               const std::array<Real3, 3>& tri,
+               const Real3& slip,
+               Real nu,
+               Real6Array& out);
+
 } // namespace ddm
 
 #endif // OPM_CUTDE_HPP_INCLUDED
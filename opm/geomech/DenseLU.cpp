@@ -0,0 +1,209 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/DenseLU.hpp>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+extern "C" {
+void dgetrf_(const int* m, const int* n, double* a, const int* lda, int* ipiv, int* info);
+void dgetrs_(const char* trans,
+             const int* n,
+             const int* nrhs,
+             const double* a,
+             const int* lda,
+             const int* ipiv,
+             double* b,
+             const int* ldb,
+             int* info);
+void sgetrf_(const int* m, const int* n, float* a, const int* lda, int* ipiv, int* info);
+void sgetrs_(const char* trans,
+             const int* n,
+             const int* nrhs,
+             const float* a,
+             const int* lda,
+             const int* ipiv,
+             float* b,
+             const int* ldb,
+             int* info);
+}
+
+namespace ddm
+{
+DenseLU::DenseLU(const Dune::DynamicMatrix<double>& A, const Precision precision)
+    : n_(A.N())
+    , precision_(precision)
+    , pivot_(n_)
+{
+    if (A.M() != n_) {
+        OPM_THROW(std::invalid_argument, "DenseLU: matrix is not square");
+    }
+
+    if (precision_ == Precision::Single) {
+        lu_single_.resize(n_ * n_);
+        for (std::size_t i = 0; i != n_; ++i) {
+            for (std::size_t j = 0; j != n_; ++j) {
+                lu_single_[j * n_ + i] = static_cast<float>(A[i][j]);
+            }
+        }
+    } else {
+        lu_.resize(n_ * n_);
+        for (std::size_t i = 0; i != n_; ++i) {
+            for (std::size_t j = 0; j != n_; ++j) {
+                lu_[j * n_ + i] = A[i][j];
+            }
+        }
+    }
+
+    if (n_ == 0) {
+        return;
+    }
+
+    const int n = static_cast<int>(n_);
+    int info = 0;
+    if (precision_ == Precision::Single) {
+        sgetrf_(&n, &n, lu_single_.data(), &n, pivot_.data(), &info);
+    } else {
+        dgetrf_(&n, &n, lu_.data(), &n, pivot_.data(), &info);
+    }
+
+    if (info != 0) {
+        OPM_THROW(std::runtime_error,
+                  "DenseLU: factorization failed (dgetrf info = " + std::to_string(info) + ")");
+    }
+}
+
+void
+DenseLU::solve(double* x, const double* b) const
+{
+    if (n_ == 0) {
+        return;
+    }
+
+    const char trans = 'N';
+    const int n = static_cast<int>(n_);
+    const int nrhs = 1;
+    int info = 0;
+
+    if (precision_ == Precision::Single) {
+        std::vector<float> xs(b, b + n_);
+        sgetrs_(&trans, &n, &nrhs, lu_single_.data(), &n, pivot_.data(), xs.data(), &n, &info);
+        std::copy(xs.begin(), xs.end(), x);
+    } else {
+        if (x != b) {
+            std::copy(b, b + n_, x);
+        }
+        dgetrs_(&trans, &n, &nrhs, lu_.data(), &n, pivot_.data(), x, &n, &info);
+    }
+
+    if (info != 0) {
+        OPM_THROW(std::runtime_error,
+                  "DenseLU: solve failed (getrs info = " + std::to_string(info) + ")");
+    }
+}
+
+void
+DenseLU::solve(double* X, const std::size_t nrhs) const
+{
+    if (n_ == 0 || nrhs == 0) {
+        return;
+    }
+
+    const char trans = 'N';
+    const int n = static_cast<int>(n_);
+    const int m = static_cast<int>(nrhs);
+    int info = 0;
+
+    if (precision_ == Precision::Single) {
+        std::vector<float> Xs(X, X + n_ * nrhs);
+        sgetrs_(&trans, &n, &m, lu_single_.data(), &n, pivot_.data(), Xs.data(), &n, &info);
+        std::copy(Xs.begin(), Xs.end(), X);
+    } else {
+        dgetrs_(&trans, &n, &m, lu_.data(), &n, pivot_.data(), X, &n, &info);
+    }
+
+    if (info != 0) {
+        OPM_THROW(std::runtime_error,
+                  "DenseLU: solve failed (getrs info = " + std::to_string(info) + ")");
+    }
+}
+
+DenseLU::RefinementResult
+DenseLU::solveRefined(const Dune::DynamicMatrix<double>& A,
+                      double* x,
+                      const double* b,
+                      const double tol,
+                      const int max_iter) const
+{
+    RefinementResult result;
+
+    if (A.N() != n_ || A.M() != n_) {
+        OPM_THROW(std::invalid_argument, "DenseLU: matrix does not match the factorization");
+    }
+
+    double b_norm = 0.0;
+    for (std::size_t i = 0; i != n_; ++i) {
+        b_norm = std::max(b_norm, std::abs(b[i]));
+    }
+
+    if (b_norm == 0.0) {
+        std::fill(x, x + n_, 0.0);
+        result.converged = true;
+        return result;
+    }
+
+    solve(x, b);
+
+    std::vector<double> r(n_);
+    while (true) {
+        // r = b - A x, in double precision
+        double r_norm = 0.0;
+        for (std::size_t i = 0; i != n_; ++i) {
+            const auto& row = A[i];
+            double ax = 0.0;
+            for (std::size_t j = 0; j != n_; ++j) {
+                ax += row[j] * x[j];
+            }
+            r[i] = b[i] - ax;
+            r_norm = std::max(r_norm, std::abs(r[i]));
+        }
+
+        result.residual = r_norm / b_norm;
+        result.converged = result.residual <= tol;
+        if (result.converged || result.iterations == max_iter) {
+            return result;
+        }
+
+        solve(r.data(), r.data());
+        for (std::size_t i = 0; i != n_; ++i) {
+            x[i] += r[i];
+        }
+
+        ++result.iterations;
+    }
+}
+
+} // namespace ddm
@@ -0,0 +1,87 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DENSE_LU_HPP_INCLUDED
+#define OPM_DENSE_LU_HPP_INCLUDED
+
+#include <dune/common/dynmatrix.hh>
+
+#include <cstddef>
+#include <vector>
+
+namespace ddm
+{
+// LU factorization (with partial pivoting) of a dense, square matrix, computed
+// once with LAPACK and reused for any number of right-hand sides.  Factorizing
+// costs O(N^3), each subsequent solve only O(N^2).
+//
+// With Precision::Single the factors are computed and stored in float, which
+// halves their memory and roughly halves the time of factorization and solves.
+// Double accuracy is then recovered with solveRefined().
+class DenseLU
+{
+public:
+    enum class Precision { Double, Single };
+
+    struct RefinementResult
+    {
+        int iterations {0}; // number of correction steps
+        double residual {0.0}; // final |b - A x|_inf / |b|_inf
+        bool converged {false};
+    };
+
+    explicit DenseLU(const Dune::DynamicMatrix<double>& A, Precision precision = Precision::Double);
+
+    Precision precision() const
+    {
+        return precision_;
+    }
+
+    std::size_t N() const
+    {
+        return n_;
+    }
+
+    // x = A^-1 b.  'x' and 'b' must have N() entries, and may be the same array.
+    void solve(double* x, const double* b) const;
+
+    // X = A^-1 X for 'nrhs' right-hand sides stored column by column in 'X'
+    void solve(double* X, std::size_t nrhs) const;
+
+    // Solves A x = b by iterative refinement: the residual is computed in double
+    // precision with 'A' (which must be the factorized matrix), and corrections
+    // with the stored factors, until the relative residual is below 'tol' or
+    // 'max_iter' corrections have been made.  'x' and 'b' may not overlap.
+    RefinementResult solveRefined(const Dune::DynamicMatrix<double>& A,
+                                  double* x,
+                                  const double* b,
+                                  double tol,
+                                  int max_iter) const;
+
+private:
+    std::size_t n_ {0};
+    Precision precision_ {Precision::Double};
+    std::vector<double> lu_; // column-major L and U factors (double precision)
+    std::vector<float> lu_single_; // column-major L and U factors (single precision)
+    std::vector<int> pivot_;
+};
+
+} // namespace ddm
+
+#endif // OPM_DENSE_LU_HPP_INCLUDED
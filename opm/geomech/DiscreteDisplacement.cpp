@@ -21,7 +21,29 @@
 
 #include <opm/geomech/DiscreteDisplacement.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <map>
+
+namespace
+{
+ddm::Real3Array
+toArray(const std::vector<Dune::FieldVector<double, 3>>& points)
+{
+    ddm::Real3Array result;
+    result.resize(points.size());
+
+    for (std::size_t i = 0; i != points.size(); ++i) {
+        result.x[i] = points[i][0];
+        result.y[i] = points[i][1];
+        result.z[i] = points[i][2];
+    }
+
+    return result;
+}
+
+} // Anonymous namespace
 
 namespace ddm
 {
@@ -99,84 +121,319 @@ tractionSymTensor(const Dune::FieldVector<double, 6>& symtensor,
     return traction;
 }
 
-void
-assembleMatrix(Dune::DynamicMatrix<double>& matrix,
-               const double E,
-               const double nu,
-               const Dune::FoamGrid<2, 3>& grid)
+TriangleTable
+makeTriangleTable(const Dune::FoamGrid<2, 3>& grid)
 {
     using Grid = Dune::FoamGrid<2, 3>;
     using GridView = typename Grid::LeafGridView;
     using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<GridView>;
 
     const ElementMapper mapper(grid.leafGridView(), Dune::mcmgElementLayout());
+    const std::size_t nc = grid.leafGridView().size(0);
+
+    TriangleTable tris;
+    tris.corners.resize(nc);
+    tris.centers.resize(nc);
+    tris.normals.resize(nc);
+
+    for (const auto& elem : elements(grid.leafGridView())) {
+        const std::size_t idx = mapper.index(elem);
+        tris.corners[idx] = getTri(elem);
+        tris.centers[idx] = elem.geometry().center();
+        tris.normals[idx] = normalOfElement(elem);
+    }
 
-    for (const auto& elem1 : elements(grid.leafGridView())) {
-        const int idx1 = mapper.index(elem1);
-        const auto center = elem1.geometry().center();
-        const auto normal = normalOfElement(elem1);
-
-        for (const auto& elem2 : elements(grid.leafGridView())) {
-            const int idx2 = mapper.index(elem2);
-            // check if this is defined in relative coordinates
-            Dune::FieldVector<double, 3> slip; // = make3(1.0,0.0, 0.0);
-            slip[0] = 1;
-            slip[1] = 0;
-            slip[2] = 0;
-
-            // symmetric stress voit notation
-            const Dune::FieldVector<double, 6> strain = TDStrainFS(center, elem2, slip, nu);
-            const Dune::FieldVector<double, 6> stress = strainToStress(E, nu, strain);
-
-            // matrix relate to pure traction not area weighted
-            matrix[idx1][idx2] = tractionSymTensor(stress, normal);
+    tris.center_array = toArray(tris.centers);
+
+    return tris;
+}
+
+double
+influenceCoefficient(const Dune::FieldVector<double, 3>& obs,
+                     const Dune::FieldVector<double, 3>& normal,
+                     const std::array<Real3, 3>& src,
+                     const double E,
+                     const double nu)
+{
+    // check if this is defined in relative coordinates
+    const Real3 slip = make3(1.0, 0.0, 0.0);
+
+    // symmetric stress voit notation
+    const Real6 s = strain_fs(make3(obs[0], obs[1], obs[2]), src, slip, nu);
+    const Dune::FieldVector<double, 6> strain {s.x, s.y, s.z, s.a, s.b, s.c};
+    const Dune::FieldVector<double, 6> stress = strainToStress(E, nu, strain);
+
+    // matrix relate to pure traction not area weighted
+    return tractionSymTensor(stress, normal);
+}
+
+double
+influenceCoefficient(const TriangleTable& tris,
+                     const std::size_t obs,
+                     const std::size_t src,
+                     const double E,
+                     const double nu)
+{
+    return influenceCoefficient(tris.centers[obs], tris.normals[obs], tris.corners[src], E, nu);
+}
+
+void
+influenceColumn(const Real3Array& points,
+                const std::vector<Dune::FieldVector<double, 3>>& normals,
+                const std::array<Real3, 3>& src,
+                const double E,
+                const double nu,
+                std::vector<double>& column)
+{
+    // check if this is defined in relative coordinates
+    const Real3 slip = make3(1.0, 0.0, 0.0);
+
+    Real6Array s;
+    strain_fs(points, src, slip, nu, s);
+
+    column.resize(points.size());
+    for (std::size_t obs = 0; obs != points.size(); ++obs) {
+        // symmetric stress voit notation
+        const Dune::FieldVector<double, 6> strain {
+            s.x[obs], s.y[obs], s.z[obs], s.a[obs], s.b[obs], s.c[obs]};
+        const Dune::FieldVector<double, 6> stress = strainToStress(E, nu, strain);
+
+        // matrix relate to pure traction not area weighted
+        column[obs] = tractionSymTensor(stress, normals[obs]);
+    }
+}
+
+void
+influenceColumn(const TriangleTable& tris,
+                const std::size_t src,
+                const double E,
+                const double nu,
+                std::vector<double>& column)
+{
+    influenceColumn(tris.center_array, tris.normals, tris.corners[src], E, nu, column);
+}
+
+void
+assembleMatrix(Dune::DynamicMatrix<double>& matrix,
+               const double E,
+               const double nu,
+               const Dune::FoamGrid<2, 3>& grid,
+               const int num_threads)
+{
+    assembleMatrix(matrix, E, nu, makeTriangleTable(grid), num_threads);
+}
+
+void
+assembleMatrix(Dune::DynamicMatrix<double>& matrix,
+               const double E,
+               const double nu,
+               const TriangleTable& tris,
+               [[maybe_unused]] const int num_threads)
+{
+    const int nc = static_cast<int>(tris.size());
+
+    // The matrix is computed column by column, evaluating the field of each
+    // source triangle at all centroids in one batch.  Columns are distributed
+    // in blocks, so that threads write to separate parts of each row.
+    const int block_size = 32;
+    const int num_blocks = (nc + block_size - 1) / block_size;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(num_threads, 1))
+#endif
+    for (int block = 0; block < num_blocks; ++block) {
+        std::vector<double> column;
+        const int col_end = std::min(nc, (block + 1) * block_size);
+        for (int idx2 = block * block_size; idx2 < col_end; ++idx2) {
+            influenceColumn(tris, idx2, E, nu, column);
+            for (int idx1 = 0; idx1 < nc; ++idx1) {
+                matrix[idx1][idx2] = column[idx1];
+            }
+        }
+    }
+}
+
+std::vector<int>
+matchTriangles(const TriangleTable& tris, const TriangleTable& old_tris)
+{
+    using Key = std::array<double, 9>;
+    const auto key = [](const std::array<Real3, 3>& corners) {
+        return Key {corners[0].x,
+                    corners[0].y,
+                    corners[0].z,
+                    corners[1].x,
+                    corners[1].y,
+                    corners[1].z,
+                    corners[2].x,
+                    corners[2].y,
+                    corners[2].z};
+    };
+
+    std::map<Key, int> old_index;
+    for (std::size_t i = 0; i != old_tris.size(); ++i) {
+        old_index.emplace(key(old_tris.corners[i]), static_cast<int>(i));
+    }
+
+    std::vector<int> result(tris.size(), -1);
+    for (std::size_t i = 0; i != tris.size(); ++i) {
+        const auto it = old_index.find(key(tris.corners[i]));
+        if (it != old_index.end()) {
+            result[i] = it->second;
+        }
+    }
+
+    return result;
+}
+
+std::size_t
+assembleMatrixIncremental(Dune::DynamicMatrix<double>& matrix,
+                          const double E,
+                          const double nu,
+                          const TriangleTable& tris,
+                          const Dune::DynamicMatrix<double>& old_matrix,
+                          const TriangleTable& old_tris,
+                          [[maybe_unused]] const int num_threads)
+{
+    const std::vector<int> old_index = matchTriangles(tris, old_tris);
+    const int nc = static_cast<int>(tris.size());
+
+    std::vector<int> kept, changed;
+    for (int i = 0; i != nc; ++i) {
+        (old_index[i] >= 0 ? kept : changed).push_back(i);
+    }
+
+    // centroids and normals of the new or moved triangles
+    std::vector<Dune::FieldVector<double, 3>> changed_centers, changed_normals;
+    for (const auto i : changed) {
+        changed_centers.push_back(tris.centers[i]);
+        changed_normals.push_back(tris.normals[i]);
+    }
+    const Real3Array changed_array = toArray(changed_centers);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(std::max(num_threads, 1))
+#endif
+    {
+        std::vector<double> column;
+
+        // entries coupling two kept triangles are unchanged
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int k = 0; k < static_cast<int>(kept.size()); ++k) {
+            const auto& old_row = old_matrix[old_index[kept[k]]];
+            auto& row = matrix[kept[k]];
+            for (const auto j : kept) {
+                row[j] = old_row[old_index[j]];
+            }
+        }
+
+        // full columns of the changed triangles
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int k = 0; k < static_cast<int>(changed.size()); ++k) {
+            influenceColumn(tris, changed[k], E, nu, column);
+            for (int i = 0; i != nc; ++i) {
+                matrix[i][changed[k]] = column[i];
+            }
+        }
+
+        // remaining entries of the rows of the changed triangles
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int k = 0; k < static_cast<int>(kept.size()); ++k) {
+            influenceColumn(changed_array, changed_normals, tris.corners[kept[k]], E, nu, column);
+            for (std::size_t r = 0; r != changed.size(); ++r) {
+                matrix[changed[r]][kept[k]] = column[r];
+            }
         }
     }
+
+    return kept.size();
 }
 
 Dune::FieldVector<double, 6>
 strain(const Dune::FieldVector<double, 3>& obs,
+       const Dune::BlockVector<Dune::FieldVector<double, 3>>& slips,
+       const Dune::FoamGrid<2, 3>& grid,
+       const double E,
+       const double nu)
+{
+    return strain(std::vector<Dune::FieldVector<double, 3>> {obs}, slips, grid, E, nu).front();
+}
+
+Dune::FieldVector<double, 3>
+disp(const Dune::FieldVector<double, 3>& obs,
+     const Dune::BlockVector<Dune::FieldVector<double, 3>>& slips,
+     const Dune::FoamGrid<2, 3>& grid,
+     const double E,
+     const double nu)
+{
+    return disp(std::vector<Dune::FieldVector<double, 3>> {obs}, slips, grid, E, nu).front();
+}
+
+std::vector<Dune::FieldVector<double, 6>>
+strain(const std::vector<Dune::FieldVector<double, 3>>& obs,
        const Dune::BlockVector<Dune::FieldVector<double, 3>>& slips,
        const Dune::FoamGrid<2, 3>& grid,
        const double /*E*/,
        const double nu)
 {
-    Dune::FieldVector<double, 6> strain;
-    strain = 0.0;
+    std::vector<Dune::FieldVector<double, 6>> strain(obs.size(), 0.0);
 
     using Grid = Dune::FoamGrid<2, 3>;
     using GridView = typename Grid::LeafGridView;
     using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<GridView>;
 
     const ElementMapper mapper(grid.leafGridView(), Dune::mcmgElementLayout());
+    const Real3Array points = toArray(obs);
+    Real6Array elem_strain;
 
     for (const auto& elem1 : elements(grid.leafGridView())) {
         const int idx1 = mapper.index(elem1);
-        strain += TDStrainFS(obs, elem1, slips[idx1], nu);
+        const auto& slip = slips[idx1];
+        strain_fs(points, getTri(elem1), make3(slip[0], slip[1], slip[2]), nu, elem_strain);
+
+        for (std::size_t i = 0; i != obs.size(); ++i) {
+            strain[i] += Dune::FieldVector<double, 6> {elem_strain.x[i],
+                                                       elem_strain.y[i],
+                                                       elem_strain.z[i],
+                                                       elem_strain.a[i],
+                                                       elem_strain.b[i],
+                                                       elem_strain.c[i]};
+        }
     }
 
     return strain;
 }
 
-Dune::FieldVector<double, 3>
-disp(const Dune::FieldVector<double, 3>& obs,
+std::vector<Dune::FieldVector<double, 3>>
+disp(const std::vector<Dune::FieldVector<double, 3>>& obs,
      const Dune::BlockVector<Dune::FieldVector<double, 3>>& slips,
      const Dune::FoamGrid<2, 3>& grid,
      const double /*E*/,
      const double nu)
 {
-    Dune::FieldVector<double, 3> disp;
-    disp = 0.0;
+    std::vector<Dune::FieldVector<double, 3>> disp(obs.size(), 0.0);
 
     using Grid = Dune::FoamGrid<2, 3>;
     using GridView = typename Grid::LeafGridView;
     using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<GridView>;
 
     const ElementMapper mapper(grid.leafGridView(), Dune::mcmgElementLayout());
+    const Real3Array points = toArray(obs);
+    Real3Array elem_disp;
 
     for (const auto& elem1 : elements(grid.leafGridView())) {
         const int idx1 = mapper.index(elem1);
-        disp += TDDispFS(obs, elem1, slips[idx1], nu);
+        const auto& slip = slips[idx1];
+        disp_fs(points, getTri(elem1), make3(slip[0], slip[1], slip[2]), nu, elem_disp);
+
+        for (std::size_t i = 0; i != obs.size(); ++i) {
+            disp[i] += Dune::FieldVector<double, 3> {elem_disp.x[i], elem_disp.y[i], elem_disp.z[i]};
+        }
     }
 
     return disp;
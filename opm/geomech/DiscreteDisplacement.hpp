@@ -34,6 +34,8 @@
 #include <opm/geomech/Math.hpp>
 
 #include <array>
+#include <cstddef>
+#include <vector>
 
 namespace ddm
 {
@@ -142,12 +144,87 @@ strainToStress(const double E, const double nu, const Dune::FieldVector<double,
 double tractionSymTensor(const Dune::FieldVector<double, 6>& symtensor,
                          const Dune::FieldVector<double, 3>& normal);
 
+// Flat per-triangle geometry of a fracture grid, indexed by the element mapper.
+// Extracted once so that the O(N^2) kernel loops do not walk Dune entities.
+struct TriangleTable
+{
+    std::vector<std::array<Real3, 3>> corners;
+    std::vector<Dune::FieldVector<double, 3>> centers;
+    std::vector<Dune::FieldVector<double, 3>> normals;
+    Real3Array center_array; // 'centers' in the layout used by the batched kernels
+
+    std::size_t size() const
+    {
+        return corners.size();
+    }
+};
+
+TriangleTable makeTriangleTable(const Dune::FoamGrid<2, 3>& grid);
+
+// normal traction at the point 'obs', on a plane with the given normal, caused by
+// a unit opening of the triangle 'src'
+double influenceCoefficient(const Dune::FieldVector<double, 3>& obs,
+                            const Dune::FieldVector<double, 3>& normal,
+                            const std::array<Real3, 3>& src,
+                            const double E,
+                            const double nu);
+
+// normal traction at the centroid of triangle 'obs' caused by a unit opening of
+// triangle 'src' (i.e. one entry of the DDM matrix)
+double influenceCoefficient(const TriangleTable& tris,
+                            const std::size_t obs,
+                            const std::size_t src,
+                            const double E,
+                            const double nu);
+
+// normal traction at 'points', on planes with the given normals, caused by a unit
+// opening of the triangle 'src', computed in one batch
+void influenceColumn(const Real3Array& points,
+                     const std::vector<Dune::FieldVector<double, 3>>& normals,
+                     const std::array<Real3, 3>& src,
+                     const double E,
+                     const double nu,
+                     std::vector<double>& column);
+
+// normal traction at the centroids of all triangles caused by a unit opening of
+// triangle 'src' (i.e. one column of the DDM matrix), computed in one batch
+void influenceColumn(const TriangleTable& tris,
+                     const std::size_t src,
+                     const double E,
+                     const double nu,
+                     std::vector<double>& column);
+
 // assembleMatrix(Dune::DynamicMatrix<Dune::FieldMatrix<double,1,1>>& matrix, const double
 // E, const double nu, const Dune::FoamGrid<2, 3>& grid)
+// If num_threads > 1 (and OpenMP is enabled), blocks of columns are assembled in parallel.
+void assembleMatrix(Dune::DynamicMatrix<double>& matrix,
+                    const double E,
+                    const double nu,
+                    const Dune::FoamGrid<2, 3>& grid,
+                    const int num_threads = 1);
+
 void assembleMatrix(Dune::DynamicMatrix<double>& matrix,
                     const double E,
                     const double nu,
-                    const Dune::FoamGrid<2, 3>& grid);
+                    const TriangleTable& tris,
+                    const int num_threads = 1);
+
+// for each triangle in 'tris', the index of the triangle in 'old_tris' with
+// exactly the same corners (in the same order), or -1 if there is none
+std::vector<int> matchTriangles(const TriangleTable& tris, const TriangleTable& old_tris);
+
+// As assembleMatrix, but entries coupling two triangles that are also found in
+// 'old_tris' are copied from 'old_matrix', which must have been assembled for
+// 'old_tris' with the same E and nu.  Only the rows and columns of new or moved
+// triangles are computed, i.e. O(N dN) instead of O(N^2) kernel evaluations.
+// Returns the number of reused triangles.
+std::size_t assembleMatrixIncremental(Dune::DynamicMatrix<double>& matrix,
+                                      const double E,
+                                      const double nu,
+                                      const TriangleTable& tris,
+                                      const Dune::DynamicMatrix<double>& old_matrix,
+                                      const TriangleTable& old_tris,
+                                      const int num_threads = 1);
 
 Dune::FieldVector<double, 6> strain(const Dune::FieldVector<double, 3>& obs,
                                     const Dune::BlockVector<Dune::FieldVector<double, 3>>& slips,
@@ -160,6 +237,22 @@ Dune::FieldVector<double, 3> disp(const Dune::FieldVector<double, 3>& obs,
                                   const Dune::FoamGrid<2, 3>& grid,
                                   const double E,
                                   const double nu);
+
+// strain and displacement at many observation points at once (much faster than
+// one point at a time, since the field of each triangle is evaluated in batch)
+std::vector<Dune::FieldVector<double, 6>>
+strain(const std::vector<Dune::FieldVector<double, 3>>& obs,
+       const Dune::BlockVector<Dune::FieldVector<double, 3>>& slips,
+       const Dune::FoamGrid<2, 3>& grid,
+       const double E,
+       const double nu);
+
+std::vector<Dune::FieldVector<double, 3>>
+disp(const std::vector<Dune::FieldVector<double, 3>>& obs,
+     const Dune::BlockVector<Dune::FieldVector<double, 3>>& slips,
+     const Dune::FoamGrid<2, 3>& grid,
+     const double E,
+     const double nu);
 } // namespace ddm
 
 #endif // DISCRETE_DISPLACEMENT_HPP_INCLUDED
@@ -0,0 +1,344 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/FieldEvaluator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using Point = ddm::FieldEvaluator::Point;
+
+// the components of the batched kernel results
+std::array<std::vector<double>*, 6>
+components(ddm::Real6Array& a)
+{
+    return {&a.x, &a.y, &a.z, &a.a, &a.b, &a.c};
+}
+
+std::array<std::vector<double>*, 3>
+components(ddm::Real3Array& a)
+{
+    return {&a.x, &a.y, &a.z};
+}
+
+// values of the Lagrange polynomials for 'nodes' at 'x'
+void
+lagrange(const std::vector<double>& nodes, const double x, std::vector<double>& result)
+{
+    result.assign(nodes.size(), 1.0);
+    for (std::size_t k = 0; k != nodes.size(); ++k) {
+        for (std::size_t j = 0; j != nodes.size(); ++j) {
+            if (j != k) {
+                result[k] *= (x - nodes[j]) / (nodes[k] - nodes[j]);
+            }
+        }
+    }
+}
+
+// Tensor grid of Chebyshev points spanning a bounding box, with the field of
+// the far sources tabulated on it.  Directions in which the box is flat get a
+// single point.
+struct Interpolation
+{
+    std::array<std::vector<double>, 3> nodes;
+    ddm::Real3Array points; // point (i, j, k) at index (i * n1 + j) * n2 + k
+    std::vector<std::vector<double>> values; // per field component
+
+    Interpolation(const Point& lo, const Point& hi, const int order, const std::size_t num_components)
+    {
+        const double flat
+            = 1e-12 * std::max(ddm::boxDiameter(lo, hi), std::numeric_limits<double>::min());
+        for (int dim = 0; dim != 3; ++dim) {
+            const double mid = 0.5 * (lo[dim] + hi[dim]);
+            const double half = 0.5 * (hi[dim] - lo[dim]);
+            const int n = half > flat ? order : 1;
+            for (int k = 0; k != n; ++k) {
+                nodes[dim].push_back(n == 1 ? mid : mid + half * std::cos((2 * k + 1) * M_PI / (2 * n)));
+            }
+        }
+
+        points.resize(size());
+        std::size_t idx = 0;
+        for (const double x : nodes[0]) {
+            for (const double y : nodes[1]) {
+                for (const double z : nodes[2]) {
+                    points.x[idx] = x;
+                    points.y[idx] = y;
+                    points.z[idx] = z;
+                    ++idx;
+                }
+            }
+        }
+
+        values.assign(num_components, std::vector<double>(size(), 0.0));
+    }
+
+    std::size_t size() const
+    {
+        return nodes[0].size() * nodes[1].size() * nodes[2].size();
+    }
+
+    // add the interpolated field at 'obs' to 'result'
+    template <std::size_t NC>
+    void addTo(const ddm::Real3Array& obs, const std::array<std::vector<double>*, NC>& result) const
+    {
+        std::array<std::vector<double>, 3> L;
+        for (std::size_t i = 0; i != obs.size(); ++i) {
+            lagrange(nodes[0], obs.x[i], L[0]);
+            lagrange(nodes[1], obs.y[i], L[1]);
+            lagrange(nodes[2], obs.z[i], L[2]);
+
+            std::size_t idx = 0;
+            for (const double l0 : L[0]) {
+                for (const double l1 : L[1]) {
+                    const double l01 = l0 * l1;
+                    for (const double l2 : L[2]) {
+                        const double w = l01 * l2;
+                        for (std::size_t c = 0; c != NC; ++c) {
+                            (*result[c])[i] += w * values[c][idx];
+                        }
+                        ++idx;
+                    }
+                }
+            }
+        }
+    }
+};
+
+} // Anonymous namespace
+
+namespace ddm
+{
+FieldEvaluator::FieldEvaluator(const std::vector<std::array<Real3, 3>>& triangles,
+                               const std::vector<Real3>& slips,
+                               const double nu,
+                               const Params& params)
+    : nu_(nu)
+    , params_(params)
+{
+    // closed cells do not contribute
+    std::vector<std::size_t> active;
+    for (std::size_t i = 0; i != triangles.size(); ++i) {
+        if (slips[i].x != 0.0 || slips[i].y != 0.0 || slips[i].z != 0.0) {
+            active.push_back(i);
+        }
+    }
+
+    if (active.empty()) {
+        return;
+    }
+
+    std::vector<Point> lo(active.size()), hi(active.size());
+    for (std::size_t i = 0; i != active.size(); ++i) {
+        const auto& tri = triangles[active[i]];
+        lo[i] = {std::min({tri[0].x, tri[1].x, tri[2].x}),
+                 std::min({tri[0].y, tri[1].y, tri[2].y}),
+                 std::min({tri[0].z, tri[1].z, tri[2].z})};
+        hi[i] = {std::max({tri[0].x, tri[1].x, tri[2].x}),
+                 std::max({tri[0].y, tri[1].y, tri[2].y}),
+                 std::max({tri[0].z, tri[1].z, tri[2].z})};
+    }
+
+    std::vector<std::size_t> perm;
+    buildClusterTree(lo, hi, params_.leaf_size, perm, tree_);
+
+    for (const auto i : perm) {
+        triangles_.push_back(triangles[active[i]]);
+        slips_.push_back(slips[active[i]]);
+    }
+}
+
+template <class Array, class Kernel>
+void
+FieldEvaluator::evaluate(const Real3Array& obs, Array& result, const Kernel& kernel) const
+{
+    const std::size_t num_points = obs.size();
+    result.resize(num_points);
+
+    const auto out = components(result);
+    constexpr std::size_t NC = std::tuple_size_v<decltype(out)>;
+    for (auto* c : out) {
+        std::fill(c->begin(), c->end(), 0.0);
+    }
+
+    if (num_points == 0 || tree_.empty()) {
+        return;
+    }
+
+    // cluster tree of the observation points
+    std::vector<Point> pts(num_points);
+    for (std::size_t i = 0; i != num_points; ++i) {
+        pts[i] = {obs.x[i], obs.y[i], obs.z[i]};
+    }
+
+    std::vector<std::size_t> perm;
+    std::vector<Cluster> targets;
+    buildClusterTree(pts, pts, params_.leaf_size, perm, targets);
+
+    // interaction lists: source clusters to be interpolated to each target
+    // cluster (far) and to be evaluated directly at its points (near)
+    const std::size_t num_nodes = static_cast<std::size_t>(std::pow(params_.order, 3));
+    std::vector<std::vector<int>> far(targets.size()), near(targets.size());
+
+    std::vector<std::pair<int, int>> stack {{0, 0}};
+    while (!stack.empty()) {
+        const auto [tc, sc] = stack.back();
+        stack.pop_back();
+
+        const auto& t = targets[tc];
+        const auto& s = tree_[sc];
+
+        const double dist = boxDistance(t.lo, t.hi, s.lo, s.hi);
+        const double t_diam = boxDiameter(t.lo, t.hi);
+        const double s_diam = boxDiameter(s.lo, s.hi);
+
+        const bool t_leaf = t.child[0] < 0;
+        const bool s_leaf = s.child[0] < 0;
+
+        if (dist > 0.0 && std::max(t_diam, s_diam) <= params_.eta * dist) {
+            // interpolation only pays off for clusters with more points than nodes
+            (t.end - t.begin > num_nodes ? far : near)[tc].push_back(sc);
+        } else if (t_leaf && s_leaf) {
+            near[tc].push_back(sc);
+        } else if (s_leaf || (!t_leaf && t_diam >= s_diam)) {
+            stack.emplace_back(t.child[0], sc);
+            stack.emplace_back(t.child[1], sc);
+        } else {
+            stack.emplace_back(tc, s.child[0]);
+            stack.emplace_back(tc, s.child[1]);
+        }
+    }
+
+    // far field, tabulated at the interpolation points of each target cluster
+    std::vector<std::unique_ptr<Interpolation>> interp(targets.size());
+    const int num_targets = static_cast<int>(targets.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(params_.num_threads, 1))
+#endif
+    for (int tc = 0; tc < num_targets; ++tc) {
+        if (far[tc].empty()) {
+            continue;
+        }
+
+        auto ip = std::make_unique<Interpolation>(targets[tc].lo, targets[tc].hi, params_.order, NC);
+        Array field;
+        for (const int sc : far[tc]) {
+            for (std::size_t j = tree_[sc].begin; j != tree_[sc].end; ++j) {
+                kernel(ip->points, triangles_[j], slips_[j], nu_, field);
+                const auto f = components(field);
+                for (std::size_t c = 0; c != NC; ++c) {
+                    for (std::size_t k = 0; k != ip->size(); ++k) {
+                        ip->values[c][k] += (*f[c])[k];
+                    }
+                }
+            }
+        }
+
+        interp[tc] = std::move(ip);
+    }
+
+    // collect all contributions for the points of each leaf
+    std::vector<int> leaves;
+    for (int tc = 0; tc != num_targets; ++tc) {
+        if (targets[tc].child[0] < 0) {
+            leaves.push_back(tc);
+        }
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(params_.num_threads, 1))
+#endif
+    for (int l = 0; l < static_cast<int>(leaves.size()); ++l) {
+        const auto& leaf = targets[leaves[l]];
+        const std::size_t n = leaf.end - leaf.begin;
+
+        Real3Array points;
+        points.resize(n);
+        for (std::size_t i = 0; i != n; ++i) {
+            points.x[i] = obs.x[perm[leaf.begin + i]];
+            points.y[i] = obs.y[perm[leaf.begin + i]];
+            points.z[i] = obs.z[perm[leaf.begin + i]];
+        }
+
+        Array sum, field;
+        sum.resize(n);
+        const auto s = components(sum);
+
+        for (int tc = leaves[l]; tc >= 0; tc = targets[tc].parent) {
+            if (interp[tc]) {
+                interp[tc]->addTo(points, s);
+            }
+
+            for (const int sc : near[tc]) {
+                for (std::size_t j = tree_[sc].begin; j != tree_[sc].end; ++j) {
+                    kernel(points, triangles_[j], slips_[j], nu_, field);
+                    const auto f = components(field);
+                    for (std::size_t c = 0; c != NC; ++c) {
+                        for (std::size_t i = 0; i != n; ++i) {
+                            (*s[c])[i] += (*f[c])[i];
+                        }
+                    }
+                }
+            }
+        }
+
+        for (std::size_t c = 0; c != NC; ++c) {
+            for (std::size_t i = 0; i != n; ++i) {
+                (*out[c])[perm[leaf.begin + i]] = (*s[c])[i];
+            }
+        }
+    }
+}
+
+void
+FieldEvaluator::strain(const Real3Array& obs, Real6Array& strain) const
+{
+    evaluate(obs,
+             strain,
+             [](const Real3Array& points,
+                const std::array<Real3, 3>& tri,
+                const Real3& slip,
+                const Real nu,
+                Real6Array& out) { strain_fs(points, tri, slip, nu, out); });
+}
+
+void
+FieldEvaluator::disp(const Real3Array& obs, Real3Array& disp) const
+{
+    evaluate(obs,
+             disp,
+             [](const Real3Array& points,
+                const std::array<Real3, 3>& tri,
+                const Real3& slip,
+                const Real nu,
+                Real3Array& out) { disp_fs(points, tri, slip, nu, out); });
+}
+
+} // namespace ddm
@@ -0,0 +1,86 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FIELD_EVALUATOR_HPP_INCLUDED
+#define OPM_FIELD_EVALUATOR_HPP_INCLUDED
+
+#include <opm/geomech/ClusterTree.hpp>
+#include <opm/geomech/CutDe.hpp>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace ddm
+{
+// Fast evaluation of the strain and displacement caused by a set of triangular
+// dislocations (the opened fracture cells) at many observation points, such as
+// reservoir cell centers.
+//
+// Triangles and observation points are organised in cluster trees.  For pairs
+// of clusters that are well separated, the (exact) field of the source cluster
+// is evaluated at a tensor grid of Chebyshev points spanning the observation
+// cluster, and interpolated to the observation points from there.  Remaining
+// pairs are evaluated directly.  The cost is O((N + M) log(N + M)) kernel
+// evaluations for N triangles and M points, instead of O(N M), and the error is
+// controlled by the interpolation order and the admissibility parameter.
+class FieldEvaluator
+{
+public:
+    using Point = std::array<double, 3>;
+
+    struct Params
+    {
+        int order {6}; // interpolation points in each direction
+        double eta {2.0}; // admissibility: max(diam) <= eta * dist
+        std::size_t leaf_size {32}; // clusters with fewer triangles/points are not subdivided
+        int num_threads {1}; // threads used for the evaluation (requires OpenMP)
+    };
+
+    // 'slips' are given per triangle, as for disp_fs and strain_fs
+    FieldEvaluator(const std::vector<std::array<Real3, 3>>& triangles,
+                   const std::vector<Real3>& slips,
+                   const double nu,
+                   const Params& params);
+
+    // strain and displacement at all points in 'obs'.  The result is resized to obs.size().
+    void strain(const Real3Array& obs, Real6Array& strain) const;
+    void disp(const Real3Array& obs, Real3Array& disp) const;
+
+    std::size_t numTriangles() const
+    {
+        return triangles_.size();
+    }
+
+private:
+    template <class Array, class Kernel>
+    void evaluate(const Real3Array& obs, Array& result, const Kernel& kernel) const;
+
+    double nu_ {0.0};
+    Params params_;
+
+    // triangles with nonzero slip, in cluster order
+    std::vector<std::array<Real3, 3>> triangles_;
+    std::vector<Real3> slips_;
+    std::vector<Cluster> tree_;
+};
+
+} // namespace ddm
+
+#endif // OPM_FIELD_EVALUATOR_HPP_INCLUDED
@@ -28,16 +28,18 @@
 #include <dune/common/fmatrixev.hh>
 #include <dune/grid/utility/persistentcontainer.hh>
 #include <dune/istl/io.hh> // needed for printSparseMatrix??
+#include <dune/istl/solvers.hh>
 
 #include <opm/grid/polyhedralgrid.hh>
 
-#include <opm/simulators/linalg/FlowLinearSolverParameters.hpp>
-#include <opm/simulators/linalg/setupPropertyTree.hpp>
 #include <opm/simulators/wells/ConnFracStatistics.hpp>
 #include <opm/simulators/wells/RuntimePerforation.hpp>
 
 #include <opm/geomech/DiscreteDisplacement.hpp>
+#include <opm/geomech/FieldEvaluator.hpp>
 #include <opm/geomech/GridStretcher.hpp>
+#include <opm/geomech/HMatrix.hpp>
+#include <opm/geomech/LatticeOperator.hpp>
 #include <opm/geomech/Math.hpp>
 #include <opm/geomech/RegularTrimesh.hpp>
 
@@ -46,14 +48,35 @@
 #include <cmath>
 #include <cstddef>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
+namespace
+{
+ddm::Real3Array
+toReal3Array(const std::vector<Dune::FieldVector<double, 3>>& points)
+{
+    ddm::Real3Array result;
+    result.resize(points.size());
+    for (std::size_t i = 0; i != points.size(); ++i) {
+        result.x[i] = points[i][0];
+        result.y[i] = points[i][1];
+        result.z[i] = points[i][2];
+    }
+
+    return result;
+}
+
+} // Anonymous namespace
+
 namespace Opm
 {
 void
@@ -69,6 +92,8 @@ Fracture::init(const std::string& well,
 {
     OPM_TIMEFUNCTION();
     prm_ = prm;
+    control_ = makeInjectionControl(prm_.get_child("control"));
+    settings_ = makeFractureSolverSettings(prm_.get_child("solver"));
     min_width_ = prm_.get<double>("config.min_width", 1e-3);
     wellinfo_ = WellInfo({well, perf, well_cell, global_index, segment, perf_range});
 
@@ -84,14 +109,14 @@ Fracture::init(const std::string& well,
         axis_[i] *= init_scale;
     }
 
-    std::cout << "axis: {" << axis_[0][0] << ',' << axis_[0][1] << ',' << axis_[0][2] << "}, { "
-              << axis_[1][0] << ',' << axis_[1][1] << ',' << axis_[1][2] << "}, { " << axis_[2][0] << ','
-              << axis_[2][1] << ',' << axis_[2][2] << '}' << std::endl;
+    outputStream() << "axis: {" << axis_[0][0] << ',' << axis_[0][1] << ',' << axis_[0][2] << "}, { "
+                   << axis_[1][0] << ',' << axis_[1][1] << ',' << axis_[1][2] << "}, { " << axis_[2][0]
+                   << ',' << axis_[2][1] << ',' << axis_[2][2] << '}' << std::endl;
 
     layers_ = 0;
     nlinear_ = 0;
 
-    const auto method = prm_.get<std::string>("solver.method");
+    const auto& method = settings_.method;
 
     if (method == "if_propagate_trimesh") {
         // const int trimeshlayers = 4;
@@ -105,9 +130,9 @@ Fracture::init(const std::string& well,
                                          0.5 * ax1[1] + fac * axis_[1][1],
                                          0.5 * ax1[2] + fac * axis_[1][2]};
 
-        std::cout << "Creating trimesh with radius: " << radius << ", edgelen: " << edgelen
-                  << ", ax1: " << ax1[0] << "," << ax1[1] << "," << ax1[2] << ", ax2: " << ax2[0] << ","
-                  << ax2[1] << "," << ax2[2] << std::endl;
+        outputStream() << "Creating trimesh with radius: " << radius << ", edgelen: " << edgelen
+                       << ", ax1: " << ax1[0] << "," << ax1[1] << "," << ax1[2] << ", ax2: " << ax2[0]
+                       << "," << ax2[1] << "," << ax2[2] << std::endl;
 
         trimesh_ = std::make_unique<RegularTrimesh>(radius, // trimeshlayers,
                                                     std::array {origo_[0], origo_[1], origo_[2]},
@@ -149,6 +174,200 @@ Fracture::init(const std::string& well,
     //    to the fracture (`reservoir_XXX_` vectors, as well as `E_` and `nu_`)
 }
 
+bool
+Fracture::solvesOnFixedGrid() const
+{
+    const auto& method = settings_.method;
+    return method == "nothing" || method == "simple" || method == "only_pressure"
+        || method == "only_width" || method == "iterative" || method == "if";
+}
+
+FractureSolveData
+Fracture::solveData() const
+{
+    FractureSolveData data;
+
+    data.well = wellinfo_.name;
+    data.perf = wellinfo_.perf;
+    data.well_cell = wellinfo_.well_cell;
+    data.global_index = wellinfo_.global_index;
+    data.segment = wellinfo_.segment;
+    data.has_perf_range = wellinfo_.perf_range.has_value();
+    if (data.has_perf_range) {
+        data.perf_range = {wellinfo_.perf_range->first, wellinfo_.perf_range->second};
+    }
+
+    for (int d = 0; d < 3; ++d) {
+        data.origo[d] = origo_[d];
+        for (int k = 0; k < 3; ++k) {
+            data.axis[3 * k + d] = axis_[k][d];
+        }
+    }
+
+    const auto& gv = grid_->leafGridView();
+    const auto& index_set = gv.indexSet();
+    data.vertices.resize(3 * gv.size(2));
+    for (const auto& vertex : vertices(gv)) {
+        const auto pos = vertex.geometry().corner(0);
+        const std::size_t i = index_set.index(vertex);
+        for (int d = 0; d < 3; ++d) {
+            data.vertices[3 * i + d] = pos[d];
+        }
+    }
+    data.triangles.resize(3 * gv.size(0));
+    for (const auto& elem : elements(gv)) {
+        const std::size_t i = index_set.index(elem);
+        for (int c = 0; c < 3; ++c) {
+            data.triangles[3 * i + c] = index_set.subIndex(elem, c, 2);
+        }
+    }
+    data.well_source = well_source_;
+
+    data.reservoir_cells = reservoir_cells_;
+    data.reservoir_perm = reservoir_perm_;
+    data.reservoir_cstress = reservoir_cstress_;
+    data.reservoir_mobility = reservoir_mobility_;
+    data.reservoir_density = reservoir_density_;
+    data.reservoir_cell_z = reservoir_cell_z_;
+    data.reservoir_dist = reservoir_dist_;
+    data.reservoir_pressure = reservoir_pressure_;
+    for (const auto& stress : reservoir_stress_) {
+        data.reservoir_stress.insert(data.reservoir_stress.end(), stress.begin(), stress.end());
+    }
+    data.filtercake_thickness = filtercake_thikness_;
+    data.filtercake_perm = filtercake_perm_;
+    data.filtercake_poro = filtercake_poro_;
+    data.has_filtercake = has_filtercake_;
+
+    data.E = E_;
+    data.nu = nu_;
+    data.perf_pressure = perf_pressure_;
+    data.total_WI_well = total_WI_well_;
+
+    data.width.assign(fracture_width_.begin(), fracture_width_.end());
+    data.pressure.assign(fracture_pressure_.begin(), fracture_pressure_.end());
+    data.active_set = active_set_;
+    data.warm_start = canWarmStart();
+
+    return data;
+}
+
+void
+Fracture::initFromSolveData(const FractureSolveData& data, const PropertyTree& prm)
+{
+    OPM_TIMEFUNCTION();
+
+    prm_ = prm;
+    control_ = makeInjectionControl(prm_.get_child("control"));
+    settings_ = makeFractureSolverSettings(prm_.get_child("solver"));
+    min_width_ = prm_.get<double>("config.min_width", 1e-3);
+
+    std::optional<std::pair<double, double>> perf_range;
+    if (data.has_perf_range) {
+        perf_range = std::pair {data.perf_range[0], data.perf_range[1]};
+    }
+    wellinfo_ = WellInfo(
+        {data.well, data.perf, data.well_cell, data.global_index, data.segment, perf_range});
+
+    for (int d = 0; d < 3; ++d) {
+        origo_[d] = data.origo[d];
+        for (int k = 0; k < 3; ++k) {
+            axis_[k][d] = data.axis[3 * k + d];
+        }
+    }
+
+    layers_ = 0;
+    nlinear_ = 0;
+    well_source_ = data.well_source;
+
+    Dune::GridFactory<Grid> factory;
+    for (std::size_t i = 0; i < data.vertices.size(); i += 3) {
+        factory.insertVertex({data.vertices[i], data.vertices[i + 1], data.vertices[i + 2]});
+    }
+    for (std::size_t i = 0; i < data.triangles.size(); i += 3) {
+        factory.insertElement(Dune::GeometryTypes::simplex(2),
+                              {data.triangles[i], data.triangles[i + 1], data.triangles[i + 2]});
+    }
+    auto grid = factory.createGrid();
+
+    // the cell data is sent in the order of the leaf index set, which FoamGrid
+    // takes over from the insertion order
+    for (const auto& elem : elements(grid->leafGridView())) {
+        if (factory.insertionIndex(elem) != grid->leafGridView().indexSet().index(elem)) {
+            OPM_THROW(std::runtime_error, "Cell order of fracture " + data.well + " not preserved");
+        }
+    }
+    setFractureGrid(std::move(grid));
+
+    reservoir_cells_ = data.reservoir_cells;
+    reservoir_perm_ = data.reservoir_perm;
+    reservoir_cstress_ = data.reservoir_cstress;
+    reservoir_mobility_ = data.reservoir_mobility;
+    reservoir_density_ = data.reservoir_density;
+    reservoir_cell_z_ = data.reservoir_cell_z;
+    reservoir_dist_ = data.reservoir_dist;
+    reservoir_pressure_ = data.reservoir_pressure;
+    reservoir_stress_.resize(data.reservoir_stress.size() / 6);
+    for (std::size_t i = 0; i != reservoir_stress_.size(); ++i) {
+        for (int k = 0; k < 6; ++k) {
+            reservoir_stress_[i][k] = data.reservoir_stress[6 * i + k];
+        }
+    }
+    filtercake_thikness_ = data.filtercake_thickness;
+    filtercake_perm_ = data.filtercake_perm;
+    filtercake_poro_ = data.filtercake_poro;
+    has_filtercake_ = data.has_filtercake;
+
+    E_ = data.E;
+    nu_ = data.nu;
+    setPerfPressure(data.perf_pressure);
+    total_WI_well_ = data.total_WI_well;
+
+    fracture_width_.resize(data.width.size());
+    std::copy(data.width.begin(), data.width.end(), fracture_width_.begin());
+    fracture_pressure_.resize(data.pressure.size());
+    std::copy(data.pressure.begin(), data.pressure.end(), fracture_pressure_.begin());
+    active_set_ = data.active_set;
+    setWarmStartState(data.warm_start);
+
+    active_ = true;
+}
+
+FractureSolveResult
+Fracture::solveResult() const
+{
+    FractureSolveResult result;
+    result.width.assign(fracture_width_.begin(), fracture_width_.end());
+    result.pressure.assign(fracture_pressure_.begin(), fracture_pressure_.end());
+    result.active_set = active_set_;
+    result.warm_start = has_warm_start_state_;
+    return result;
+}
+
+void
+Fracture::setSolveResult(const FractureSolveResult& result)
+{
+    const std::size_t nc = numFractureCells();
+    if (result.width.size() != nc || result.pressure.size() != nc + numWellEquations()) {
+        OPM_THROW(std::runtime_error, "Fracture solution of " + name() + " does not match its grid");
+    }
+
+    fracture_width_.resize(nc);
+    std::copy(result.width.begin(), result.width.end(), fracture_width_.begin());
+    fracture_pressure_.resize(result.pressure.size());
+    std::copy(result.pressure.begin(), result.pressure.end(), fracture_pressure_.begin());
+    active_set_ = result.active_set;
+    setWarmStartState(result.warm_start);
+    if (result.warm_start) {
+        recordSolveInputs();
+    }
+    ++solve_statistics_.full;
+
+    // the leakoff, from which the well indices are computed, is otherwise updated
+    // during the solve
+    updateLeakoff();
+}
+
 void
 Fracture::resetWriters()
 {
@@ -170,17 +389,13 @@ Fracture::resetWriters()
 void
 Fracture::setupPressureSolver()
 {
-    Opm::FlowLinearSolverParameters p;
-    p.linsolver_ = prm_.get<std::string>("pressuresolver");
-    prmpressure_ = Opm::setupPropertyTree(p, true, true);
-
-    const std::size_t pressureIndex = 0; // Dummy
-    const std::function<Vector()> weightsCalculator; // Dummy
-
-    pressure_operator_ = std::make_unique<PressureOperatorType>(*pressure_matrix_);
-
-    pressure_solver_ = std::make_unique<FlexibleSolverType>(
-        *pressure_operator_, prmpressure_, weightsCalculator, pressureIndex);
+    pressure_solver_
+        = std::make_unique<FracturePressureSolver>(prm_.get<std::string>("pressuresolver"),
+                                                   prm_.get<double>("pressuresolver_tol", 1e-10),
+                                                   prm_.get<int>("pressuresolver_max_iter", 200),
+                                                   prm_.get<int>("pressuresolver_verbosity", 0));
+    pressure_solver_->setOutputStream(outputStream());
+    pressure_solver_->setMatrix(*pressure_matrix_);
 }
 
 /**
@@ -229,6 +444,7 @@ Fracture::removeCells()
         std::size_t eIdx = mapper.index(elem);
         fracture_width_[eIdx] = fracture_width[elem];
     }
+    updateGeometry();
     this->resetWriters();
 }
 
@@ -266,11 +482,9 @@ Fracture::updateFilterCakeProps(const Opm::WellConnections& connections,
         if (!leakof_.empty()) { // should be first step with seed fracture is clean could
                                 // have used rates from solve
             assert(leakof_.size() == fracture_pressure_.size());
-            const ElementMapper mapper(grid_->leafGridView(), Dune::mcmgElementLayout());
-            for (const auto& element : Dune::elements(grid_->leafGridView())) {
-                const int eIdx = mapper.index(element);
+            for (std::size_t eIdx = 0; eIdx < geometry_.size(); ++eIdx) {
                 const int res_cell = reservoir_cells_[eIdx];
-                const double area = element.geometry().volume(); // is the area of this face
+                const double area = geometry_.areas[eIdx]; // is the area of this face
 
                 reservoir_areas[res_cell] += area;
 
@@ -280,8 +494,8 @@ Fracture::updateFilterCakeProps(const Opm::WellConnections& connections,
                 reservoir_flux[res_cell] += flux;
 
                 if (flux < 0) {
-                    std::cout << "Negative flux " << flux << " for element index " << eIdx
-                              << " with reservoir cell " << res_cell << std::endl;
+                    outputStream() << "Negative flux " << flux << " for element index " << eIdx
+                                   << " with reservoir cell " << res_cell << std::endl;
                     flux = 0.0;
                 }
 
@@ -296,21 +510,21 @@ Fracture::updateFilterCakeProps(const Opm::WellConnections& connections,
         const ElementMapper mapper(grid_->leafGridView(), Dune::mcmgElementLayout());
         for (const auto& [res_cell, flux] : reservoir_flux) {
             if (reservoir_areas.find(res_cell) == reservoir_areas.end()) {
-                std::cout << "Reservoir area not found for element index " << res_cell << std::endl;
+                outputStream() << "Reservoir area not found for element index " << res_cell << std::endl;
                 continue;
             }
 
             const double frac_flux = reservoir_flux[res_cell];
             if (res_cell != wellinfo_.well_cell) {
                 if (std::abs(flux - WI_fluxes[res_cell]) > 0) {
-                    std::cout << "Fracture flux differs from flow flux " << res_cell << '\n'
-                              << "Flux: frac " << frac_flux << " vs res " << WI_fluxes[res_cell]
-                              << std::endl;
+                    outputStream() << "Fracture flux differs from flow flux " << res_cell << '\n'
+                                   << "Flux: frac " << frac_flux << " vs res " << WI_fluxes[res_cell]
+                                   << std::endl;
                 }
             } else {
-                std::cout << "Total WI flux " << WI_fluxes[res_cell] << " for cell " << res_cell
-                          << " matches fracture flux " << frac_flux
-                          << std::endl; //" for element index " << eIdx << std::endl;
+                outputStream() << "Total WI flux " << WI_fluxes[res_cell] << " for cell " << res_cell
+                               << " matches fracture flux " << frac_flux
+                               << std::endl; //" for element index " << eIdx << std::endl;
             }
         }
     }
@@ -322,10 +536,7 @@ Fracture::all_slips() const
     Dune::BlockVector<Dune::FieldVector<double, 3>> slips(grid_->leafGridView().size(0));
     slips = 0;
 
-    const ElementMapper mapper(grid_->leafGridView(), Dune::mcmgElementLayout());
-
-    for (const auto& elem : Dune::elements(grid_->leafGridView())) {
-        std::size_t eIdx = mapper.index(elem);
+    for (std::size_t eIdx = 0; eIdx < slips.size(); ++eIdx) {
         // only normal slip for now
         slips[eIdx][0] = fracture_width_[eIdx];
     }
@@ -336,14 +547,13 @@ Fracture::all_slips() const
 Dune::FieldVector<double, 3>
 Fracture::disp(const Dune::FieldVector<double, 3>& obs) const
 {
-    return ddm::disp(obs, this->all_slips(), *grid_, E_, nu_);
+    return this->disp(std::vector<Dune::FieldVector<double, 3>> {obs}).front();
 }
 
 Dune::FieldVector<double, 6>
 Fracture::strain(const Dune::FieldVector<double, 3>& obs) const
 {
-    // for now use full slip in interface even we only calculate normal slip
-    return ddm::strain(obs, this->all_slips(), *grid_, E_, nu_);
+    return this->strain(std::vector<Dune::FieldVector<double, 3>> {obs}).front();
 }
 
 Dune::FieldVector<double, 6>
@@ -353,6 +563,92 @@ Fracture::stress(const Dune::FieldVector<double, 3>& obs) const
     return ddm::strainToStress(E_, nu_, this->strain(obs));
 }
 
+std::vector<Dune::FieldVector<double, 3>>
+Fracture::disp(const std::vector<Dune::FieldVector<double, 3>>& obs) const
+{
+    if (!useFieldEvaluator()) {
+        return ddm::disp(obs, this->all_slips(), *grid_, E_, nu_);
+    }
+
+    ddm::Real3Array disp;
+    fieldEvaluator().disp(toReal3Array(obs), disp);
+
+    std::vector<Dune::FieldVector<double, 3>> result(obs.size());
+    for (std::size_t i = 0; i != obs.size(); ++i) {
+        result[i] = {disp.x[i], disp.y[i], disp.z[i]};
+    }
+
+    return result;
+}
+
+std::vector<Dune::FieldVector<double, 6>>
+Fracture::strain(const std::vector<Dune::FieldVector<double, 3>>& obs) const
+{
+    // for now use full slip in interface even we only calculate normal slip
+    if (!useFieldEvaluator()) {
+        return ddm::strain(obs, this->all_slips(), *grid_, E_, nu_);
+    }
+
+    ddm::Real6Array strain;
+    fieldEvaluator().strain(toReal3Array(obs), strain);
+
+    std::vector<Dune::FieldVector<double, 6>> result(obs.size());
+    for (std::size_t i = 0; i != obs.size(); ++i) {
+        result[i] = {strain.x[i], strain.y[i], strain.z[i], strain.a[i], strain.b[i], strain.c[i]};
+    }
+
+    return result;
+}
+
+bool
+Fracture::useFieldEvaluator() const
+{
+    return settings_.tree_field;
+}
+
+const ddm::FieldEvaluator&
+Fracture::fieldEvaluator() const
+{
+    // rebuilt whenever the widths have changed since it was built
+    const std::size_t nc = numFractureCells();
+    bool up_to_date = field_evaluator_ != nullptr && field_evaluator_widths_.size() == nc;
+    for (std::size_t i = 0; up_to_date && i != nc; ++i) {
+        up_to_date = field_evaluator_widths_[i] == fracture_width_[i][0];
+    }
+
+    if (!up_to_date) {
+        const auto slips = this->all_slips();
+        std::vector<ddm::Real3> slip3(nc);
+        field_evaluator_widths_.resize(nc);
+        for (std::size_t i = 0; i != nc; ++i) {
+            slip3[i] = ddm::make3(slips[i][0], slips[i][1], slips[i][2]);
+            field_evaluator_widths_[i] = fracture_width_[i][0];
+        }
+
+        ddm::FieldEvaluator::Params params;
+        params.order = settings_.field_order;
+        params.eta = settings_.field_eta;
+        params.leaf_size = settings_.field_leaf_size;
+        params.num_threads = settings_.ddm_threads;
+
+        field_evaluator_ = std::make_unique<ddm::FieldEvaluator>(
+            geometry_.triangles.corners, slip3, nu_, params);
+    }
+
+    return *field_evaluator_;
+}
+
+std::vector<Dune::FieldVector<double, 6>>
+Fracture::stress(const std::vector<Dune::FieldVector<double, 3>>& obs) const
+{
+    auto stress = this->strain(obs);
+    for (auto& s : stress) {
+        s = this->strainToStress(s);
+    }
+
+    return stress;
+}
+
 std::string
 Fracture::name() const
 {
@@ -362,14 +658,219 @@ Fracture::name() const
 }
 
 void
-Fracture::updateCellNormals()
+Fracture::updateGeometry()
 {
-    cell_normals_.resize(numFractureCells());
+    geometry_ = makeFractureGeometryCache(*grid_);
+    ++grid_revision_;
+    active_set_.clear();
+    shadow_traction_.clear();
 
-    const ElementMapper elemMapper(grid_->leafGridView(), Dune::mcmgElementLayout());
-    for (const auto& element : elements(grid_->leafGridView())) {
-        cell_normals_[elemMapper.index(element)] = ddm::normalOfElement(element);
+    cell_normals_.resize(geometry_.size());
+    for (std::size_t i = 0; i < geometry_.size(); ++i) {
+        cell_normals_[i] = geometry_.triangles.normals[i];
+    }
+}
+
+bool
+Fracture::canWarmStart() const
+{
+    return settings_.warm_start && canContinueSolve();
+}
+
+bool
+Fracture::canContinueSolve() const
+{
+    const std::size_t nc = numFractureCells();
+
+    return has_warm_start_state_ && warm_start_grid_revision_ == grid_revision_
+        && fracture_width_.size() == nc && fracture_pressure_.size() == nc + numWellEquations();
+}
+
+void
+Fracture::setWarmStartState(const bool valid)
+{
+    has_warm_start_state_ = valid;
+    warm_start_grid_revision_ = grid_revision_;
+}
+
+FractureSolveKind
+Fracture::plannedSolve() const
+{
+    if (solved_inputs_.grid_revision != grid_revision_) {
+        return FractureSolveKind::Full;
+    }
+
+    const double change = inputChange();
+    if (change < settings_.reuse_tol) {
+        return FractureSolveKind::Skipped;
+    }
+    if (change < settings_.correction_tol && settings_.method == "if" && canContinueSolve()) {
+        return FractureSolveKind::Correction;
+    }
+    return FractureSolveKind::Full;
+}
+
+std::vector<double>
+Fracture::normalTractions(const std::vector<Dune::FieldVector<double, 6>>& stress,
+                          const std::vector<double>& shadow_traction) const
+{
+    const std::size_t nc = std::min(numFractureCells(), stress.size());
+    std::vector<double> traction(nc);
+    for (std::size_t eIdx = 0; eIdx < nc; ++eIdx) {
+        const double shadow = shadow_traction.empty() ? 0.0 : shadow_traction[eIdx];
+        traction[eIdx] = ddm::tractionSymTensor(stress[eIdx], cell_normals_[eIdx]) - shadow;
+    }
+    return traction;
+}
+
+void
+Fracture::recordSolveInputs()
+{
+    solved_inputs_.grid_revision = grid_revision_;
+    solved_inputs_.stress = reservoir_stress_;
+    solved_inputs_.shadow_traction = shadow_traction_;
+    solved_inputs_.pressure = reservoir_pressure_;
+    solved_inputs_.mobility = reservoir_mobility_;
+    solved_inputs_.filtercake = filtercake_thikness_;
+    solved_inputs_.perf_pressure = perf_pressure_;
+}
+
+double
+Fracture::inputChange() const
+{
+    // largest change of each input relative to its largest previous magnitude
+    const auto change = [](const std::vector<double>& previous, const std::vector<double>& current) {
+        if (previous.size() != current.size()) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        double diff = 0.0;
+        double scale = 0.0;
+        for (std::size_t i = 0; i < current.size(); ++i) {
+            diff = std::max(diff, std::abs(current[i] - previous[i]));
+            scale = std::max(scale, std::abs(previous[i]));
+        }
+        return diff == 0.0 ? 0.0 : diff / scale;
+    };
+
+    const double perf_diff = std::abs(perf_pressure_ - solved_inputs_.perf_pressure);
+    double result = perf_diff == 0.0 ? 0.0 : perf_diff / std::abs(solved_inputs_.perf_pressure);
+    result = std::max(result,
+                      change(normalTractions(solved_inputs_.stress, solved_inputs_.shadow_traction),
+                             normalTractions(reservoir_stress_, shadow_traction_)));
+    result = std::max(result, change(solved_inputs_.pressure, reservoir_pressure_));
+    result = std::max(result, change(solved_inputs_.mobility, reservoir_mobility_));
+    result = std::max(result, change(solved_inputs_.filtercake, filtercake_thikness_));
+    return result;
+}
+
+bool
+Fracture::solveInSubsteps(const std::function<bool(int&)>& iterate)
+{
+    const std::size_t nc = numFractureCells();
+    const auto& start = solved_inputs_;
+    if (start.stress.size() != nc || start.pressure.size() != reservoir_pressure_.size()
+        || start.mobility.size() != reservoir_mobility_.size()) {
+        int iterations = 0;
+        return iterate(iterations);
+    }
+
+    // inputs at the end of the step
+    const auto stress = reservoir_stress_;
+    const auto shadow_traction = shadow_traction_;
+    const auto pressure = reservoir_pressure_;
+    const auto mobility = reservoir_mobility_;
+    const double perf_pressure = perf_pressure_;
+
+    const auto blend = [](const std::vector<double>& v0,
+                          const std::vector<double>& v1,
+                          const double theta,
+                          std::vector<double>& v) {
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            v[i] = (1.0 - theta) * v0[i] + theta * v1[i];
+        }
+    };
+
+    const auto set_inputs = [&](const double theta) {
+        for (std::size_t i = 0; i < nc; ++i) {
+            reservoir_stress_[i] = start.stress[i];
+            reservoir_stress_[i] *= 1.0 - theta;
+            reservoir_stress_[i].axpy(theta, stress[i]);
+        }
+        // an empty shadow traction is zero
+        if (!start.shadow_traction.empty() || !shadow_traction.empty()) {
+            const std::vector<double> zero(nc, 0.0);
+            shadow_traction_.resize(nc);
+            blend(start.shadow_traction.empty() ? zero : start.shadow_traction,
+                  shadow_traction.empty() ? zero : shadow_traction,
+                  theta,
+                  shadow_traction_);
+        }
+        blend(start.pressure, pressure, theta, reservoir_pressure_);
+        blend(start.mobility, mobility, theta, reservoir_mobility_);
+        perf_pressure_ = (1.0 - theta) * start.perf_pressure + theta * perf_pressure;
+    };
+
+    // converged state at the start of the current sub-step
+    Vector width0 = fracture_width_;
+    Vector pressure0 = fracture_pressure_;
+    std::vector<int> active_set0 = active_set_;
+
+    const int target_iter = std::max(settings_.substep_target_iter, 1);
+    double theta = 0.0;
+    double dtheta = 1.0;
+    int num_substeps = 0;
+    bool converged = false;
+    while (theta < 1.0) {
+        const double next = std::min(theta + dtheta, 1.0);
+        set_inputs(next);
+
+        int iterations = 0;
+        converged = iterate(iterations);
+        if (converged) {
+            theta = next;
+            ++num_substeps;
+            width0 = fracture_width_;
+            pressure0 = fracture_pressure_;
+            active_set0 = active_set_;
+            dtheta *= std::clamp(static_cast<double>(target_iter) / std::max(iterations, 1), 0.5, 2.0);
+            continue;
+        }
+
+        // the failed iterate belongs to intermediate inputs, so restart from the last
+        // converged sub-step
+        fracture_width_ = width0;
+        fracture_pressure_ = pressure0;
+        active_set_ = active_set0;
+
+        if (0.5 * dtheta < settings_.min_substep) {
+            // one final attempt at the end of the step, as without sub-stepping
+            outputStream() << "Fracture sub-step " << dtheta << " at " << theta
+                           << " did not converge, solving for the end of the step from the "
+                              "last converged sub-step"
+                           << std::endl;
+            set_inputs(1.0);
+            converged = iterate(iterations);
+            break;
+        }
+
+        dtheta *= 0.5;
+        if (settings_.verbosity > 0) {
+            outputStream() << "Fracture sub-step did not converge, cut to " << dtheta << std::endl;
+        }
+    }
+
+    if (num_substeps > 1 || settings_.verbosity > 0) {
+        outputStream() << "Fracture solved in " << num_substeps << " sub-steps" << std::endl;
     }
+
+    reservoir_stress_ = stress;
+    shadow_traction_ = shadow_traction;
+    reservoir_pressure_ = pressure;
+    reservoir_mobility_ = mobility;
+    perf_pressure_ = perf_pressure;
+
+    return converged;
 }
 
 void
@@ -398,8 +899,8 @@ Fracture::setFractureGrid(std::unique_ptr<Fracture::Grid> gptr)
         grid_ = std::move(gptr);
     }
 
-    // compute the cell normals
-    updateCellNormals();
+    // compute the cell normals and the per-cell geometry used by the flow equations
+    updateGeometry();
 
     // set object to allow stretching of the grid // @@ do not use with trimesh
     if (trimesh_ == nullptr) {
@@ -413,7 +914,7 @@ Fracture::setFractureGrid(std::unique_ptr<Fracture::Grid> gptr)
     // reservoir cells has been invalidated, and the fracture matrix (for
     // mechanics) is obsolete.
     reservoir_cells_.clear();
-    fracture_matrix_ = nullptr;
+    invalidateFractureMatrix();
 
     this->resetWriters();
 }
@@ -470,20 +971,13 @@ Fracture::stressIntensityK1() const
 
     std::vector<double> stressIntensityK1(nc, std::nan("0"));
 
-    ElementMapper mapper(grid_->leafGridView(), Dune::mcmgElementLayout());
-    for (const auto& elem : elements(grid_->leafGridView())) {
-        const auto& elCenter = elem.geometry().center();
-
-        for (const auto& is : Dune::intersections(grid_->leafGridView(), elem)) {
-            if (!is.boundary()) {
-                continue;
-            }
-
-            const auto distC = (is.geometry().center() - elCenter).two_norm();
-            const int nIdx = mapper.index(elem);
-
-            stressIntensityK1[nIdx] = ddm::fractureK1(distC, fracture_width_[nIdx], this->E_, this->nu_);
+    for (std::size_t nIdx = 0; nIdx < nc; ++nIdx) {
+        const double distC = geometry_.boundary_dist[nIdx];
+        if (std::isnan(distC)) {
+            continue; // interior cell
         }
+
+        stressIntensityK1[nIdx] = ddm::fractureK1(distC, fracture_width_[nIdx], this->E_, this->nu_);
     }
 
     return stressIntensityK1;
@@ -550,8 +1044,8 @@ Fracture::write(int reportStep) const
 void
 Fracture::writemulti(double time) const
 {
-    std::cout << "Writing fracture data to VTK files at time: " << time << "grid_size"
-              << numFractureCells() << std::endl;
+    outputStream() << "Writing fracture data to VTK files at time: " << time << "grid_size"
+                   << numFractureCells() << std::endl;
 
     //  need to have copies in case of async outout (and interface to functions)
     std::vector<double> K1 = this->stressIntensityK1();
@@ -801,17 +1295,17 @@ Fracture::updateReservoirCells(const external::cvf::ref<external::cvf::BoundingB
         }
     }
 
-    std::cout << "For Fracture : " << this->name() << " : " << tri_divide
-              << " triangles should be devided" << std::endl;
-    std::cout << "For Fracture : " << this->name() << " : " << tri_outside << " triangles outside"
-              << std::endl;
-    std::cout << "Total triangles: " << numFractureCells() << std::endl;
+    outputStream() << "For Fracture : " << this->name() << " : " << tri_divide
+                   << " triangles should be devided" << std::endl;
+    outputStream() << "For Fracture : " << this->name() << " : " << tri_outside << " triangles outside"
+                   << std::endl;
+    outputStream() << "Total triangles: " << numFractureCells() << std::endl;
 
     auto it = std::find(reservoir_cells_.begin(), reservoir_cells_.end(), -1);
 
     const auto extended_fractures = prm_.get<bool>("extended_fractures");
     if ((it != reservoir_cells_.end()) && !extended_fractures) {
-        std::cout << "Remove fracture outside of model" << std::endl;
+        outputStream() << "Remove fracture outside of model" << std::endl;
         // remove fracture outside of model
         this->removeCells();
         this->updateReservoirCells(cellSearchTree);
@@ -845,7 +1339,7 @@ Fracture::updateReservoirProperties()
 }
 
 void
-Fracture::addSource()
+Fracture::initSource()
 {
     if (rhs_pressure_.size() == 0) {
         std::size_t nc = numFractureCells();
@@ -857,16 +1351,22 @@ Fracture::addSource()
     // add contributions for fracture fracture gravity contributions
     int nc = grid_->leafGridView().size(0);
     fracture_dgh_.resize(nc, 0.0);
-    for (auto element : Dune::elements(grid_->leafGridView())) {
-        // int i = Dune::MultipleCodimMultipleGeomTypeMapper<Grid::LeafGridView,
-        // Dune::mcmgElementLayout>::index(element);
-        int i = grid_->leafGridView().indexSet().index(element);
-        double z = element.geometry().center()[2];
-        fracture_dgh_[i] = gravity_ * reservoir_density_[i] * z;
+    for (int i = 0; i < nc; ++i) {
+        fracture_dgh_[i] = gravity_ * reservoir_density_[i] * geometry_.z(i);
     }
+}
+
+void
+Fracture::addSource()
+{
+    initSource();
 
     // could be put into the assemble loop
-    for (const auto& [i, j, t1, t2] : htrans_) {
+    for (std::size_t k = 0; k < htrans_.size(); ++k) {
+        const std::size_t i = htrans_.i[k];
+        const std::size_t j = htrans_.j[k];
+        const double t1 = htrans_.t1[k];
+        const double t2 = htrans_.t2[k];
         const double h1 = fracture_width_[i] + min_width_;
         const double h2 = fracture_width_[j] + min_width_;
 
@@ -883,88 +1383,87 @@ Fracture::addSource()
         rhs_pressure_[j] += value * dh;
     }
 
+    addLocalSources();
+}
+
+void
+Fracture::addLocalSources()
+{
     for (std::size_t i = 0; i < reservoir_pressure_.size(); ++i) {
         rhs_pressure_[i] += leakof_[i] * reservoir_pressure_[i];
     }
 
     // gravity contribution from fracture to reservoir
-    for (auto element : Dune::elements(grid_->leafGridView())) {
-        const int i = grid_->leafGridView().indexSet().index(element);
-        const double z = element.geometry().center()[2];
+    for (std::size_t i = 0; i < geometry_.size(); ++i) {
+        const double z = geometry_.z(i);
 
         rhs_pressure_[i] += leakof_[i] * (z - reservoir_cell_z_[i]) * gravity_ * reservoir_density_[i];
     }
 
     // gravity contributions between fracture cells
 
-    const auto control = prm_.get_child("control");
-    const std::string control_type = control.get<std::string>("type");
-
-    if (control_type == "rate") {
-        const double scale = well_source_.size();
-        const double rate = control.get<double>("rate");
-        for (const auto& cell : well_source_) {
-            rhs_pressure_[cell] += rate / scale;
-        }
-    } else if (control_type == "pressure") {
-        const double pressure = control.get<double>("pressure");
-        for (const auto& perfinj : perfinj_) {
-            const int cell = std::get<0>(perfinj);
-            const double value = std::get<1>(perfinj);
-            const double dh_perf = origo_[2] * gravity_ * reservoir_density_[cell];
-            const double dh_cell = fracture_dgh_[cell];
-            const double dh = dh_perf - dh_cell;
-            rhs_pressure_[cell] += value * (pressure - dh);
-        }
-    } else if (control_type == "perf_pressure") {
-        for (const auto& perfinj : perfinj_) {
-            const int cell = std::get<0>(perfinj);
-            const double value = std::get<1>(perfinj);
-            const double dh_perf = origo_[2] * gravity_ * reservoir_density_[cell];
-            const double dh_cell = fracture_dgh_[cell];
-            const double dh = dh_perf - dh_cell;
-            rhs_pressure_[cell] += value * (perf_pressure_ - dh);
-        }
-    } else if (control_type == "rate_well") {
-        assert(numWellEquations() == 1); // @@ for now, we assume there is just one well equation
-        const double r = control.get<double>("rate") / 24 / 60 / 60; // convert to m3/sec
-        const double WI = control.get<double>("WI");
-        const int cell = std::get<0>(perfinj_[0]); // @@ will this be the correct index?
-        const double pres = reservoir_pressure_[cell];
-        const double lambda = reservoir_mobility_[0]; // @@ only correct if mobility is constant!
-        rhs_pressure_[rhs_pressure_.size() - 1] = r + WI * lambda * pres; // well source term
-    } else {
-        OPM_THROW(std::runtime_error, "Unknowns control");
-    }
+    std::visit(
+        [this](const auto& control) {
+            using Control = std::decay_t<decltype(control)>;
+            if constexpr (std::is_same_v<Control, RateControl>) {
+                const double scale = well_source_.size();
+                for (const auto& cell : well_source_) {
+                    rhs_pressure_[cell] += control.rate / scale;
+                }
+            } else if constexpr (std::is_same_v<Control, RateWellControl>) {
+                // @@ for now, we assume there is just one well equation
+                assert(numWellEquations() == 1);
+                const double r = control.rate / 24 / 60 / 60; // convert to m3/sec
+                const int cell = std::get<0>(perfinj_[0]); // @@ will this be the correct index?
+                const double pres = reservoir_pressure_[cell];
+                const double lambda = reservoir_mobility_[0]; // @@ only correct if mobility is constant!
+                // well source term
+                rhs_pressure_[rhs_pressure_.size() - 1] = r + control.WI * lambda * pres;
+            } else {
+                // pressure given at the perforation, either fixed or from the well model
+                double pressure = perf_pressure_;
+                if constexpr (std::is_same_v<Control, PressureControl>) {
+                    pressure = control.pressure;
+                }
+                for (const auto& perfinj : perfinj_) {
+                    const int cell = std::get<0>(perfinj);
+                    const double value = std::get<1>(perfinj);
+                    const double dh_perf = origo_[2] * gravity_ * reservoir_density_[cell];
+                    const double dh_cell = fracture_dgh_[cell];
+                    const double dh = dh_perf - dh_cell;
+                    rhs_pressure_[cell] += value * (pressure - dh);
+                }
+            }
+        },
+        control_);
 }
 
 double
 Fracture::injectionPressure() const
 {
-    const std::string control_type = prm_.get<std::string>("control.type");
-
-    if (control_type == "rate") {
-        double bhp = 0.0;
-        double scale = well_source_.size();
-
-        // could have corrected for WI
-        for (const auto& cell : well_source_) {
-            bhp += fracture_pressure_[cell] / scale;
-        }
-
-        return bhp;
-    } else if (control_type == "pressure") {
-        return prm_.get<double>("control.pressure");
-    } else if (control_type == "perf_pressure") {
-        return perf_pressure_;
-    } else if (control_type == "rate_well") {
-        // @@ We should use perf_pressure_ here too, but ensure it is updated
-        return fracture_pressure_[fracture_pressure_.size() - 1][0];
-    } else {
-        OPM_THROW(std::runtime_error, "Unknowns control");
-    }
+    return std::visit(
+        [this](const auto& control) -> double {
+            using Control = std::decay_t<decltype(control)>;
+            if constexpr (std::is_same_v<Control, RateControl>) {
+                double bhp = 0.0;
+                double scale = well_source_.size();
+
+                // could have corrected for WI
+                for (const auto& cell : well_source_) {
+                    bhp += fracture_pressure_[cell] / scale;
+                }
 
-    return 0.0;
+                return bhp;
+            } else if constexpr (std::is_same_v<Control, PressureControl>) {
+                return control.pressure;
+            } else if constexpr (std::is_same_v<Control, PerfPressureControl>) {
+                return perf_pressure_;
+            } else {
+                // @@ We should use perf_pressure_ here too, but ensure it is updated
+                return fracture_pressure_[fracture_pressure_.size() - 1][0];
+            }
+        },
+        control_);
 }
 
 std::vector<double>
@@ -974,15 +1473,12 @@ Fracture::leakOfRate() const
         return {};
     }
 
-    ElementMapper mapper(grid_->leafGridView(), Dune::mcmgElementLayout());
-
     std::vector<double> leakofrate(numFractureCells(), 0);
-    for (auto& element : Dune::elements(grid_->leafGridView())) {
-        const int eIdx = mapper.index(element);
+    for (std::size_t eIdx = 0; eIdx < leakofrate.size(); ++eIdx) {
         const double dp = (fracture_pressure_[eIdx] - reservoir_pressure_[eIdx]);
         const double q = leakof_[eIdx] * dp;
 
-        leakofrate[eIdx] = q / element.geometry().volume();
+        leakofrate[eIdx] = q / geometry_.areas[eIdx];
     }
 
     return leakofrate;
@@ -1007,9 +1503,7 @@ Fracture::wellIndices() const
     std::vector<double> p_cells(res_cells.size(), 0.0);
 
     double q_prev = 0;
-    ElementMapper mapper(grid_->leafGridView(), Dune::mcmgElementLayout());
-    for (auto& element : Dune::elements(grid_->leafGridView())) {
-        const int eIdx = mapper.index(element);
+    for (std::size_t eIdx = 0; eIdx < numFractureCells(); ++eIdx) {
         const double dp = (fracture_pressure_[eIdx] - reservoir_pressure_[eIdx]);
         const double q = leakof_[eIdx] * dp;
         const int res_cell = reservoir_cells_[eIdx];
@@ -1041,7 +1535,7 @@ Fracture::wellIndices() const
         double WI = q_cells[i] / ((inj_press - dh_perf) - (p_cells[i] - dh_res));
 
         if (WI < 0.0) {
-            std::cout << "Negative WI: " << WI << " for cell: " << res_cells[i] << std::endl;
+            outputStream() << "Negative WI: " << WI << " for cell: " << res_cells[i] << std::endl;
             WI = 0.0;
         }
 
@@ -1112,22 +1606,26 @@ Fracture::solvePressure()
     fracture_pressure_ = 1e5;
     assert(pressure_matrix_); // should always be constructed at this pointn
 
-    this->assemblePressure();
-    this->addSource(); // probably include reservoir pressure
+    if (settings_.fused_assembly) {
+        this->assembleFlowSystem(nullptr);
+    } else {
+        this->assemblePressure();
+        this->addSource(); // probably include reservoir pressure
+    }
     this->writePressureSystem();
 
     try {
         if (!pressure_solver_) {
             this->setupPressureSolver();
+        } else {
+            // same sparsity, new values
+            pressure_solver_->setOutputStream(outputStream());
+            pressure_solver_->updateValues();
         }
 
-        fracture_pressure_.resize(rhs_pressure_.size());
-        fracture_pressure_ = 0;
-
-        Dune::InverseOperatorResult r {};
-        pressure_solver_->apply(fracture_pressure_, rhs_pressure_, r);
+        pressure_solver_->solve(fracture_pressure_, rhs_pressure_);
     } catch (Dune::ISTLError& e) {
-        std::cerr << "exception thrown " << e << std::endl;
+        outputStream() << "exception thrown " << e << std::endl;
     }
 }
 
@@ -1136,21 +1634,63 @@ Fracture::solvePressure()
 void
 Fracture::solveFractureWidth()
 {
-    fractureMatrix().solve(fracture_width_, rhs_width_);
+    if (useMatrixFreeOperator()) {
+        // no factorization available, so solve iteratively
+        const auto& A = fractureOperator();
+        ddm::MatrixFreeLinearOperator<Vector> op(A);
+        ddm::MatrixFreeJacobi<Vector> precond(A);
+        Dune::InverseOperatorResult res {};
+
+        auto rhs = rhs_width_; // will be modified by the solver
+        fracture_width_.resize(A.N());
+        fracture_width_ = 0;
+
+        Dune::BiCGSTABSolver<Vector> solver(op,
+                                            precond,
+                                            settings_.linsolver_tol,
+                                            settings_.linsolver_max_iter,
+                                            settings_.linsolver_verbosity);
+        solver.apply(fracture_width_, rhs, res);
+
+        if (!res.converged) {
+            outputStream() << "Matrix-free fracture width solve did not converge" << std::endl;
+        }
+    } else {
+        // the factorization is reused as long as the matrix is unchanged
+        const auto& lu = fractureMatrixLU();
+        fracture_width_.resize(lu.N());
+
+        if (lu.precision() == ddm::DenseLU::Precision::Single) {
+            // recover double accuracy from the single precision factors
+            const auto res = lu.solveRefined(fractureMatrix(),
+                                             &fracture_width_[0][0],
+                                             &rhs_width_[0][0],
+                                             settings_.refinement_tol,
+                                             settings_.refinement_max_iter);
+
+            if (!res.converged || settings_.verbosity > 0) {
+                outputStream() << "Fracture width refinement: " << res.iterations
+                               << " iterations, residual " << res.residual
+                               << (res.converged ? "" : " (not converged)") << std::endl;
+            }
+        } else {
+            lu.solve(&fracture_width_[0][0], &rhs_width_[0][0]);
+        }
+    }
 
-    const double max_width = prm_.get<double>("solver.max_width");
-    const double min_width = prm_.get<double>("solver.min_width");
+    const double max_width = settings_.max_width;
+    const double min_width = settings_.min_width;
 
     for (auto& width : this->fracture_width_) {
         assert(std::isfinite(width));
 
         if (width > max_width) {
-            std::cout << "Limit Fracture width" << std::endl;
+            outputStream() << "Limit Fracture width" << std::endl;
             width = max_width;
         }
 
         if (width < min_width) {
-            std::cout << "Remove small Fracture width" << std::endl;
+            outputStream() << "Remove small Fracture width" << std::endl;
             width = min_width;
         }
 
@@ -1163,6 +1703,7 @@ Fracture::initFractureStates()
 {
     this->initFractureWidth();
     this->initFracturePressureFromReservoir();
+    solved_inputs_.grid_revision = -1; // the next solve starts afresh
 }
 
 void
@@ -1190,12 +1731,8 @@ Fracture::updateLeakoff()
     const std::size_t nc = numFractureCells();
     leakof_.resize(nc, 0.0);
 
-    ElementMapper mapper(grid_->leafGridView(), Dune::mcmgElementLayout());
-
-    for (auto& element : Dune::elements(grid_->leafGridView())) {
-        const int eIdx = mapper.index(element);
-        const auto geom = element.geometry();
-        const double area = geom.volume();
+    for (std::size_t eIdx = 0; eIdx < nc; ++eIdx) {
+        const double area = geometry_.areas[eIdx];
         const double res_mob = reservoir_mobility_[eIdx];
 
         leakof_[eIdx] = res_mob * reservoir_perm_[eIdx] * area / reservoir_dist_[eIdx];
@@ -1273,7 +1810,6 @@ Fracture::initPressureMatrix()
     const double fWI = prm_.get<double>("fractureWI");
 
     perfinj_.clear();
-    htrans_.clear();
 
     for (const auto& cell : well_source_) {
         perfinj_.emplace_back(cell, fWI);
@@ -1283,50 +1819,30 @@ Fracture::initPressureMatrix()
     const std::size_t nc = numFractureCells() + numWellEquations();
 
     // leakof_.resize(nc,0.0);
-    const ElementMapper mapper(grid_->leafGridView(), Dune::mcmgElementLayout());
-
-    for (auto& element : Dune::elements(grid_->leafGridView())) {
-        const int eIdx = mapper.index(element);
-        const auto geom = element.geometry();
-        const auto eCenter = geom.center();
-
-        // iterator over all intersections
-        for (const auto& is : Dune::intersections(grid_->leafGridView(), element)) {
-            if (is.boundary()) {
-                continue;
-            }
-
-            const int nIdx = mapper.index(is.outside());
-            if (!(eIdx < nIdx)) {
-                continue;
-            }
-
-            // calculate distance between the midpoints
-            const auto nCenter = is.outside().geometry().center();
-            const auto isCenter = is.geometry().center();
-            const auto d_inside = eCenter - isCenter;
-            const auto d_outside = nCenter - isCenter;
-
-            // probably should use projected distance
-            const auto igeom = is.geometry();
-            const double area = igeom.volume();
-            const double h1 = area / d_inside.two_norm();
-            const double h2 = area / d_outside.two_norm();
-
-            {
-                Htrans matel(nIdx, eIdx, h1, h2);
-                htrans_.push_back(matel);
-            }
-        }
-    }
-
+    const std::size_t nf = geometry_.faces.size();
+    htrans_.i.resize(nf);
+    htrans_.j.resize(nf);
+    htrans_.t1.resize(nf);
+    htrans_.t2.resize(nf);
+    for (std::size_t k = 0; k < nf; ++k) {
+        const auto& face = geometry_.faces[k];
+        htrans_.i[k] = face.j;
+        htrans_.j[k] = face.i;
+        htrans_.t1[k] = face.h_i;
+        htrans_.t2[k] = face.h_j;
+    }
+
+    pressure_solver_ = nullptr; // set up again for the new sparsity
     pressure_matrix_ = std::make_unique<Matrix>(nc, nc, 4, 0.4, Matrix::implicit);
 
+    // the coupling matrix has the sparsity of the connections, so must be rebuilt as well
+    coupling_matrix_ = nullptr;
+
     auto& matrix = *pressure_matrix_;
 
-    for (const auto& matel : htrans_) {
-        const std::size_t i = std::get<0>(matel);
-        const std::size_t j = std::get<1>(matel);
+    for (std::size_t k = 0; k < nf; ++k) {
+        const std::size_t i = htrans_.i[k];
+        const std::size_t j = htrans_.j[k];
         const double zero_entry = 0.0; // 1e-11;
 
         matrix.entry(i, j) = zero_entry; // 0;
@@ -1348,6 +1864,53 @@ Fracture::initPressureMatrix()
     }
 
     matrix.compress();
+
+    pressure_slots_ = matrixSlots(matrix, htrans_);
+}
+
+const double*
+Fracture::matrixValues(const Matrix& matrix)
+{
+    // values of a compressed BCRSMatrix are stored contiguously, row by row, starting
+    // with the first entry of the first non-empty row
+    for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+        if (row->begin() != row->end()) {
+            return &(*row->begin())[0][0];
+        }
+    }
+    return nullptr;
+}
+
+Fracture::MatrixSlots
+Fracture::matrixSlots(const Matrix& matrix, const FlowConnections& connections)
+{
+    MatrixSlots slots;
+    const std::size_t nf = connections.size();
+    if (nf == 0) {
+        return slots;
+    }
+
+    const double* values = matrixValues(matrix);
+    const auto slot = [&](const std::size_t row, const std::size_t col) {
+        const auto it = matrix[row].find(col);
+        assert(it != matrix[row].end());
+        return static_cast<std::size_t>(&(*it)[0][0] - values);
+    };
+
+    slots.ij.resize(nf);
+    slots.ji.resize(nf);
+    slots.ii.resize(nf);
+    slots.jj.resize(nf);
+    for (std::size_t k = 0; k < nf; ++k) {
+        const std::size_t i = connections.i[k];
+        const std::size_t j = connections.j[k];
+        slots.ij[k] = slot(i, j);
+        slots.ji[k] = slot(j, i);
+        slots.ii[k] = slot(i, i);
+        slots.jj[k] = slot(j, j);
+    }
+
+    return slots;
 }
 
 void
@@ -1360,7 +1923,13 @@ Fracture::assemblePressure()
 
     // double mobility=1e4; //1e4; // @@ 1.0
     //  get head in all fracture cells
-    for (const auto& [i, j, t1, t2] : htrans_) {
+    double* const values = matrixValues(matrix);
+    const auto& slots = pressure_slots_;
+    for (std::size_t k = 0; k < htrans_.size(); ++k) {
+        const std::size_t i = htrans_.i[k];
+        const std::size_t j = htrans_.j[k];
+        const double t1 = htrans_.t1[k];
+        const double t2 = htrans_.t2[k];
         const double h1 = fracture_width_[i] + min_width_;
         const double h2 = fracture_width_[j] + min_width_;
 
@@ -1370,51 +1939,62 @@ Fracture::assemblePressure()
         double value = 12. / (h1 * h1 * h1 * t1) + 12. / (h2 * h2 * h2 * t2);
         value = mobility / value;
 
-        matrix[i][j] -= value;
-        matrix[j][i] -= value;
-        matrix[i][i] += value;
-        matrix[j][j] += value;
+        values[slots.ij[k]] -= value;
+        values[slots.ji[k]] -= value;
+        values[slots.ii[k]] += value;
+        values[slots.jj[k]] += value;
     }
 
-    const auto control = prm_.get_child("control");
-    const std::string control_type = control.get<std::string>("type");
+    assemblePressureLocal();
+}
+
+void
+Fracture::assemblePressureLocal()
+{
+    auto& matrix = *pressure_matrix_;
     for (std::size_t i = 0; i < leakof_.size(); ++i) {
         // matrix.entry(i, i) += leakof_[i];
         matrix[i][i] += leakof_[i];
     }
 
-    if (control_type == "rate") {
-        // no extra tings in matrix
-    } else if (control_type == "pressure" || control_type == "perf_pressure") {
-        for (const auto& perfinj : perfinj_) {
-            int cell = std::get<0>(perfinj);
-            double value = std::get<1>(perfinj);
-            matrix[cell][cell] += value;
-        }
-    } else if (control_type == "rate_well") {
-        assert(numWellEquations() == 1); // @@ for now, we assume there is just one well equation
-        const int nc = numFractureCells() + numWellEquations();
-        const double lambda = reservoir_mobility_[0]; // @@ If not constant, this might be wrong
-        const double WI_lambda = control.get<double>("WI") * lambda;
-        matrix[nc - 1][nc - 1] = WI_lambda;
-        // NB: well_source_[i] is assumed to be the same as get<0>(perfinj_[i])
-        for (const auto& pi : perfinj_) {
-            const int i = std::get<0>(pi);
-            const double value = std::get<1>(pi) * lambda;
-            matrix[nc - 1][i] = -value; // well equation
-            matrix[nc - 1][nc - 1] += value; // well equation
-            matrix[i][nc - 1] = -value;
-            matrix[i][i] += value;
-        }
-    } else {
-        OPM_THROW(std::runtime_error, "Unknown control of injection into Fracture");
-    }
+    std::visit(
+        [this, &matrix](const auto& control) {
+            using Control = std::decay_t<decltype(control)>;
+            if constexpr (std::is_same_v<Control, RateControl>) {
+                // no extra tings in matrix
+            } else if constexpr (std::is_same_v<Control, RateWellControl>) {
+                // @@ for now, we assume there is just one well equation
+                assert(numWellEquations() == 1);
+                const int nc = numFractureCells() + numWellEquations();
+                const double lambda = reservoir_mobility_[0]; // @@ If not constant, this might be wrong
+                const double WI_lambda = control.WI * lambda;
+                matrix[nc - 1][nc - 1] = WI_lambda;
+                // NB: well_source_[i] is assumed to be the same as get<0>(perfinj_[i])
+                for (const auto& pi : perfinj_) {
+                    const int i = std::get<0>(pi);
+                    const double value = std::get<1>(pi) * lambda;
+                    matrix[nc - 1][i] = -value; // well equation
+                    matrix[nc - 1][nc - 1] += value; // well equation
+                    matrix[i][nc - 1] = -value;
+                    matrix[i][i] += value;
+                }
+            } else {
+                // pressure or perf_pressure
+                for (const auto& perfinj : perfinj_) {
+                    int cell = std::get<0>(perfinj);
+                    double value = std::get<1>(perfinj);
+                    matrix[cell][cell] += value;
+                }
+            }
+        },
+        control_);
 }
 
 double
 Fracture::normalFractureTraction(std::size_t eIdx) const
 {
-    return ddm::tractionSymTensor(reservoir_stress_[eIdx], cell_normals_[eIdx]);
+    const double shadow = shadow_traction_.empty() ? 0.0 : shadow_traction_[eIdx];
+    return ddm::tractionSymTensor(reservoir_stress_[eIdx], cell_normals_[eIdx]) - shadow;
 }
 
 void
@@ -1440,7 +2020,6 @@ Fracture::updateFractureRHS()
     rhs_width_ = fracture_pressure_;
 
     for (std::size_t i = 0; i < rhs_width_.size(); ++i) {
-        std::cout << i << " " << rhs_width_[i] << std::endl;
         rhs_width_[i] = rhs_width_[i] - normalFractureTraction(i);
         if (rhs_width_[i] < 0.0) {
             rhs_width_[i] = 0.0; // @@ not entirely accurate, but will avoid
@@ -1462,19 +2041,202 @@ Fracture::assembleFractureMatrix() const
     fracture_matrix_->resize(nc, nc);
     *fracture_matrix_ = 0.0;
 
-    ddm::assembleMatrix(*fracture_matrix_, E_, nu_, *grid_);
+    const int num_threads = settings_.ddm_threads;
+    fracture_matrix_tris_ = geometry_.triangles;
+
+    if (previous_fracture_matrix_ && settings_.incremental_assembly) {
+        // only compute the couplings of triangles that are new or have moved
+        const std::size_t num_kept = ddm::assembleMatrixIncremental(*fracture_matrix_,
+                                                                    E_,
+                                                                    nu_,
+                                                                    fracture_matrix_tris_,
+                                                                    *previous_fracture_matrix_,
+                                                                    previous_fracture_matrix_tris_,
+                                                                    num_threads);
+        if (settings_.verbosity > 0) {
+            outputStream() << "Fracture matrix: reused " << num_kept << " of " << nc << " cells"
+                           << std::endl;
+        }
+    } else {
+        ddm::assembleMatrix(*fracture_matrix_, E_, nu_, fracture_matrix_tris_, num_threads);
+    }
+
+    previous_fracture_matrix_ = nullptr;
+    previous_fracture_matrix_tris_ = ddm::TriangleTable {};
+}
+
+void
+Fracture::assembleFractureOperator() const
+{
+    OPM_TIMEFUNCTION();
+
+    const auto& tris = geometry_.triangles;
+    const int verbosity = settings_.verbosity;
+
+    if (settings_.ddm_storage == "lattice") {
+        if (trimesh_ != nullptr && grid_mesh_map_.size() == tris.size()) {
+            fracture_operator_ = makeLatticeOperator(tris);
+            return;
+        }
+
+        if (verbosity > 0) {
+            outputStream() << "Lattice storage requires a RegularTrimesh grid, using H-matrix"
+                           << std::endl;
+        }
+    }
+
+    std::vector<ddm::HMatrix::Point> centers(tris.size());
+    for (std::size_t i = 0; i != tris.size(); ++i) {
+        centers[i] = {tris.centers[i][0], tris.centers[i][1], tris.centers[i][2]};
+    }
+
+    ddm::HMatrix::Params params;
+    params.tol = settings_.hmatrix_tol;
+    params.leaf_size = settings_.hmatrix_leaf_size;
+    params.eta = settings_.hmatrix_eta;
+    params.num_threads = settings_.ddm_threads;
+
+    const double E = E_;
+    const double nu = nu_;
+    const auto kernel = [&tris, E, nu](std::size_t i, std::size_t j) {
+        return ddm::influenceCoefficient(tris, i, j, E, nu);
+    };
+
+    auto hmatrix = std::make_unique<ddm::HMatrix>(centers, centers, kernel, params);
+
+    if (verbosity > 0) {
+        outputStream() << "Fracture H-matrix: " << tris.size() << " cells, compression "
+                       << hmatrix->compressionRatio() << ", max rank " << hmatrix->maxRank()
+                       << std::endl;
+    }
+
+    fracture_operator_ = std::move(hmatrix);
+}
+
+std::unique_ptr<ddm::MatrixFreeOperator>
+Fracture::makeLatticeOperator(const ddm::TriangleTable& tris) const
+{
+    // lattice vectors of the trimesh
+    const auto node0 = trimesh_->nodeCoord({0, 0});
+    const auto node1 = trimesh_->nodeCoord({1, 0});
+    const auto node2 = trimesh_->nodeCoord({0, 1});
+    const Dune::FieldVector<double, 3> e1 {
+        node1[0] - node0[0], node1[1] - node0[1], node1[2] - node0[2]};
+    const Dune::FieldVector<double, 3> e2 {
+        node2[0] - node0[0], node2[1] - node0[1], node2[2] - node0[2]};
+
+    // fine-scale trimesh cells are on the lattice, everything else is irregular
+    std::vector<ddm::LatticeOperator::LatticeIndex> cells(tris.size(), {0, 0, -1});
+    for (std::size_t i = 0; i != tris.size(); ++i) {
+        if (grid_mesh_map_[i].size() == 1) {
+            cells[i] = grid_mesh_map_[i].front();
+        }
+    }
+
+    // the first cell of each orientation serves as reference.  Any cell that is
+    // not an exact translate of it (e.g. differently ordered corners) is
+    // treated as irregular.
+    std::array<int, 2> ref {-1, -1};
+    const double tol = 1e-8 * e1.two_norm();
+    for (std::size_t i = 0; i != tris.size(); ++i) {
+        const int o = cells[i][2];
+        if (o < 0) {
+            continue;
+        }
+
+        if (ref[o] < 0) {
+            ref[o] = i;
+            continue;
+        }
+
+        auto shift = e1;
+        shift *= cells[i][0] - cells[ref[o]][0];
+        shift.axpy(cells[i][1] - cells[ref[o]][1], e2);
+
+        for (int k = 0; k != 3; ++k) {
+            const auto& c = tris.corners[i][k];
+            const auto& r = tris.corners[ref[o]][k];
+            if (std::abs(c.x - r.x - shift[0]) > tol || std::abs(c.y - r.y - shift[1]) > tol
+                || std::abs(c.z - r.z - shift[2]) > tol) {
+                cells[i][2] = -1;
+                break;
+            }
+        }
+    }
+
+    const double E = E_;
+    const double nu = nu_;
+    const auto lattice_kernel = [&](int o_obs, int o_src, int di, int dj) {
+        if (ref[o_obs] < 0 || ref[o_src] < 0) {
+            return 0.0; // orientation not present
+        }
+
+        // observation point, relative to the reference source cell
+        auto obs = tris.centers[ref[o_obs]];
+        obs.axpy(di - (cells[ref[o_obs]][0] - cells[ref[o_src]][0]), e1);
+        obs.axpy(dj - (cells[ref[o_obs]][1] - cells[ref[o_src]][1]), e2);
+
+        return ddm::influenceCoefficient(obs, tris.normals[ref[o_obs]], tris.corners[ref[o_src]], E, nu);
+    };
+
+    const auto kernel = [&tris, E, nu](std::size_t i, std::size_t j) {
+        return ddm::influenceCoefficient(tris, i, j, E, nu);
+    };
+
+    auto result
+        = std::make_unique<ddm::LatticeOperator>(cells, lattice_kernel, kernel, settings_.ddm_threads);
+
+    if (settings_.verbosity > 0) {
+        outputStream() << "Fracture lattice operator: " << result->numLatticeCells()
+                       << " lattice cells, " << result->numIrregularCells()
+                       << " irregular cells, compression " << result->compressionRatio() << std::endl;
+    }
+
+    return result;
+}
+
+void
+Fracture::fractureMatrixUmv(const ResVector& x, ResVector& y) const
+{
+    if (useMatrixFreeOperator()) {
+        fractureOperator().umv(&x[0][0], &y[0][0]);
+    } else {
+        fractureMatrix().umv(x, y);
+    }
+}
+
+void
+Fracture::invalidateFractureMatrix(const bool keep_for_reuse)
+{
+    if (keep_for_reuse && fracture_matrix_) {
+        // keep the old entries, which are still valid for triangles that are unchanged
+        previous_fracture_matrix_ = std::move(fracture_matrix_);
+        previous_fracture_matrix_tris_ = std::move(fracture_matrix_tris_);
+    } else if (!keep_for_reuse) {
+        previous_fracture_matrix_ = nullptr;
+        previous_fracture_matrix_tris_ = ddm::TriangleTable {};
+    }
+
+    fracture_matrix_ = nullptr;
+    fracture_matrix_tris_ = ddm::TriangleTable {};
+    fracture_matrix_lu_ = nullptr;
+    fracture_matrix_single_ = nullptr;
+    system_workspace_.a_diag.clear();
+    system_workspace_.a_row_sums.clear();
+    fracture_operator_ = nullptr;
+    field_evaluator_ = nullptr;
 }
 
 void
 Fracture::printPressureMatrix() const // debug purposes
 {
-    Dune::printSparseMatrix(std::cout, *pressure_matrix_, "matname", "linameo");
+    Dune::printSparseMatrix(outputStream(), *pressure_matrix_, "matname", "linameo");
 }
 
 void
 Fracture::printMechMatrix() const // debug purposes
 {
-    Dune::printmatrix(std::cout, fractureMatrix(), "matname", "linameo");
+    Dune::printmatrix(outputStream(), fractureMatrix(), "matname", "linameo");
 }
 
 template void Fracture::assignGeomechWellState(ConnFracStatistics<float>&) const;
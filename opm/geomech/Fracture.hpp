@@ -50,8 +50,16 @@
 #include <opm/simulators/linalg/PropertyTree.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 
+#include <opm/geomech/DenseLU.hpp>
+#include <opm/geomech/DiscreteDisplacement.hpp>
+#include <opm/geomech/FieldEvaluator.hpp>
+#include <opm/geomech/FractureDistribution.hpp>
+#include <opm/geomech/FractureGeometryCache.hpp>
+#include <opm/geomech/FracturePressureSolver.hpp>
+#include <opm/geomech/FractureSettings.hpp>
 #include <opm/geomech/GeometryHelpers.hpp>
 #include <opm/geomech/GridStretcher.hpp>
+#include <opm/geomech/MatrixFreeOperator.hpp>
 #include <opm/geomech/RegularTrimesh.hpp>
 
 #include <algorithm>
@@ -65,6 +73,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace Opm
@@ -96,6 +105,26 @@ struct WellInfo
 
 struct RuntimePerforation;
 
+// kind of a fracture solve, chosen from the change of the inputs since the last full
+// solve (see "solver.reuse_tol" and "solver.correction_tol")
+enum class FractureSolveKind { Full, Correction, Skipped };
+
+// number of fracture solves of each kind
+struct FractureSolveStatistics
+{
+    int full {0};
+    int correction {0};
+    int skipped {0};
+
+    FractureSolveStatistics& operator+=(const FractureSolveStatistics& other)
+    {
+        full += other.full;
+        correction += other.correction;
+        skipped += other.skipped;
+        return *this;
+    }
+};
+
 /// This class carries all parameters for the NewtonIterationBlackoilInterleaved class.
 class Fracture
 {
@@ -106,6 +135,40 @@ public:
     using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
     using DynamicMatrix = Dune::DynamicMatrix<double>;
 
+    // flow connections between neighbouring fracture cells i and j, stored as arrays,
+    // with geometric half transmissibilities t1 (of cell i) and t2 (of cell j)
+    struct FlowConnections
+    {
+        std::vector<std::size_t> i;
+        std::vector<std::size_t> j;
+        std::vector<double> t1;
+        std::vector<double> t2;
+
+        std::size_t size() const
+        {
+            return i.size();
+        }
+    };
+
+    // positions of the (i,j), (j,i), (i,i) and (j,j) entries of each flow connection
+    // in the value array of a (compressed) sparse matrix, so that assembly writes
+    // directly to them instead of searching the rows
+    struct MatrixSlots
+    {
+        std::vector<std::size_t> ij;
+        std::vector<std::size_t> ji;
+        std::vector<std::size_t> ii;
+        std::vector<std::size_t> jj;
+    };
+
+    static MatrixSlots matrixSlots(const Matrix& matrix, const FlowConnections& connections);
+    // start of the value array of a compressed matrix (nullptr if it has no entries)
+    static const double* matrixValues(const Matrix& matrix);
+    static double* matrixValues(Matrix& matrix)
+    {
+        return const_cast<double*>(matrixValues(static_cast<const Matrix&>(matrix)));
+    }
+
     void init(const std::string& well,
               const int perf,
               const int well_cell,
@@ -137,6 +200,11 @@ public:
     void initFractureStates();
     void initFractureWidth();
     void solveFractureWidth();
+    // scaled residual norms (converged below 1) of the iterations of the last solve
+    const std::vector<double>& residualHistory() const
+    {
+        return residual_history_;
+    }
     void solvePressure();
 
     template <class TypeTag, class Simulator>
@@ -173,6 +241,20 @@ public:
     Dune::FieldVector<double, 6> strain(const Dune::FieldVector<double, 3>& obs) const;
     Dune::FieldVector<double, 3> disp(const Dune::FieldVector<double, 3>& obs) const;
 
+    // stress corresponding to a strain, with the elastic parameters of this fracture
+    Dune::FieldVector<double, 6> strainToStress(const Dune::FieldVector<double, 6>& strain) const
+    {
+        return ddm::strainToStress(E_, nu_, strain);
+    }
+
+    // fields at many points at once, using the batched kernels
+    std::vector<Dune::FieldVector<double, 6>>
+    stress(const std::vector<Dune::FieldVector<double, 3>>& obs) const;
+    std::vector<Dune::FieldVector<double, 6>>
+    strain(const std::vector<Dune::FieldVector<double, 3>>& obs) const;
+    std::vector<Dune::FieldVector<double, 3>>
+    disp(const std::vector<Dune::FieldVector<double, 3>>& obs) const;
+
     template <typename Scalar>
     void assignGeomechWellState(ConnFracStatistics<Scalar>& stats) const;
 
@@ -186,6 +268,76 @@ public:
         return active_;
     }
 
+    std::size_t numFractureCells() const
+    {
+        return grid_->leafGridView().size(0);
+    }
+
+    // stream for the progress output of the fracture (std::cout by default), which
+    // lets concurrent solves of several fractures buffer their output
+    void setOutputStream(std::ostream& os)
+    {
+        output_ = &os;
+    }
+
+    // per-iteration dumps of the state of method "if" to files in the working
+    // directory (on by default), which concurrent solves would write to together
+    void setDebugDumps(bool enable)
+    {
+        debug_dumps_ = enable;
+    }
+
+    // solving on another rank (see FractureDistribution.hpp).  Only possible if the
+    // solve method keeps the grid, since propagation needs the reservoir grid.
+    bool solvesOnFixedGrid() const;
+    FractureSolveData solveData() const;
+    // set up a fracture from the data of another rank, with the parameters 'prm'
+    void initFromSolveData(const FractureSolveData& data, const PropertyTree& prm);
+    FractureSolveResult solveResult() const;
+    void setSolveResult(const FractureSolveResult& result);
+
+    // coupling to other fractures (see FractureInteraction.hpp)
+    const ddm::TriangleTable& triangles() const
+    {
+        return geometry_.triangles;
+    }
+
+    const Vector& fractureWidth() const
+    {
+        return fracture_width_;
+    }
+
+    double youngsModulus() const
+    {
+        return E_;
+    }
+
+    double poissonsRatio() const
+    {
+        return nu_;
+    }
+
+    int gridRevision() const
+    {
+        return grid_revision_;
+    }
+
+    // normal traction on the cells caused by the openings of other fractures, which
+    // is subtracted from the traction of the reservoir stress (cleared when the grid
+    // changes)
+    void setShadowTraction(std::vector<double> traction)
+    {
+        shadow_traction_ = std::move(traction);
+    }
+
+    // kind of solve the next call of solve() does with the current inputs
+    FractureSolveKind plannedSolve() const;
+
+    const FractureSolveStatistics& solveStatistics() const
+    {
+        return solve_statistics_;
+    }
+
 private:
     std::vector<double> redistribute_values(const std::vector<double>& values,
                                             const std::vector<std::vector<CellRef>>& map1,
@@ -209,13 +361,19 @@ private:
     using SMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>; // sparse matrix
     using FMatrix = Dune::DynamicMatrix<double>; // full matrix
 
-    std::size_t numFractureCells() const
+    std::ostream& outputStream() const
     {
-        return grid_->leafGridView().size(0);
+        return *output_;
     }
 
-    std::vector<int>
-    identify_closed(const FMatrix& A, const VectorHP& x, const ResVector& rhs, const int nwells);
+    // 'Ah' is the product of the fracture matrix with the current aperture x[_0]
+    std::vector<int> identify_closed(const ResVector& Ah, const VectorHP& x, const ResVector& rhs);
+    // closed cells by the primal-dual active set rule, with 'a_diag' the diagonal of
+    // the fracture matrix
+    std::vector<int> identify_active_set(const ResVector& Ah,
+                                         const VectorHP& x,
+                                         const ResVector& rhs,
+                                         const std::vector<double>& a_diag) const;
     template <class TypeTag, class Simulator>
     void initReservoirProperties(const Simulator& simulator)
     {
@@ -263,6 +421,11 @@ private:
             numax = std::max(numax, problem.pRatio(cell));
         }
 
+        if (Emax != E_ || numax != nu_) {
+            // the fracture matrix is proportional to E and depends on nu
+            invalidateFractureMatrix(false);
+        }
+
         E_ = Emax;
         nu_ = numax;
 
@@ -289,6 +452,8 @@ private:
     std::array<Point3D, 3> axis_;
     WellInfo wellinfo_;
     bool active_ {false}; // is fracture active?
+    std::ostream* output_ {&std::cout};
+    bool debug_dumps_ {true};
     std::unique_ptr<Dune::VTKWriter<Grid::LeafGridView>> vtkwriter_;
     static constexpr auto VTKFormat = Dune::VTK::ascii;
     std::unique_ptr<::Opm::VtkMultiWriter<Grid::LeafGridView, VTKFormat>> vtkmultiwriter_;
@@ -306,11 +471,19 @@ private:
     // help function for solving
     void assemblePressure();
     void addSource();
+    // parts of assemblePressure() and addSource() not involving the flow connections
+    void assemblePressureLocal();
+    void initSource();
+    void addLocalSources();
+    // assemblePressure() and addSource() in a single pass over the flow connections,
+    // also computing the aperture derivatives of the flow terms into 'coupling' (if
+    // given).  Results are identical to those of the separate functions.
+    void assembleFlowSystem(Matrix* coupling);
     void initPressureMatrix();
     void setupPressureSolver();
     void updateFractureRHS();
     void updateLeakoff();
-    void updateCellNormals();
+    void updateGeometry();
     void normalFractureTraction(Dune::BlockVector<Dune::FieldVector<double, 1>>& traction,
                                 bool resize = true) const;
     double normalFractureTraction(std::size_t ix) const;
@@ -318,11 +491,75 @@ private:
     // one nonlinear iteration of fully coupled system.  Returns 'true' if converged
     bool fullSystemIteration(const double tol);
 
+    // state of the nonlinear solver of method "if": damping factor of the line search
+    // and scaled residual norm of each iteration (reset at the start of each solve)
+    double step_factor_ {1.0};
+    std::vector<double> residual_history_;
+    // closed cells of the last iteration with "solver.contact" = "active_set", kept
+    // across iterations and solves (cleared when the grid changes)
+    std::vector<int> active_set_;
+    std::vector<double> shadow_traction_; // see setShadowTraction()
+
+    // warm start: if "solver.warm_start" is set, a solve continues from the state
+    // left by the previous one, provided that it converged and the grid is unchanged
+    bool has_warm_start_state_ {false};
+    int grid_revision_ {0}; // incremented by updateGeometry()
+    int warm_start_grid_revision_ {-1};
+    bool canWarmStart() const;
+    // whether the state is a converged solution on the current grid
+    bool canContinueSolve() const;
+    void setWarmStartState(bool valid);
+
+    // inputs of the last full solve, against which plannedSolve() measures the change
+    // and from which solveInSubsteps() starts (only valid while the grid revision is
+    // unchanged)
+    struct SolveInputs
+    {
+        int grid_revision {-1};
+        std::vector<Dune::FieldVector<double, 6>> stress;
+        std::vector<double> shadow_traction;
+        std::vector<double> pressure;
+        std::vector<double> mobility;
+        std::vector<double> filtercake;
+        double perf_pressure {0.0};
+    };
+    SolveInputs solved_inputs_;
+    FractureSolveStatistics solve_statistics_;
+    std::vector<double> normalTractions(const std::vector<Dune::FieldVector<double, 6>>& stress,
+                                        const std::vector<double>& shadow_traction) const;
+    void recordSolveInputs();
+    double inputChange() const;
+
+    // Advance the solution from the inputs of the last full solve to the current
+    // ones in sub-steps, interpolating the inputs linearly.  'iterate' runs the
+    // nonlinear iterations of one sub-step, sets their number and returns whether they
+    // converged.  A sub-step that fails is retried with half the size, a fast one lets
+    // the next grow.  Returns whether the last sub-step converged.
+    bool solveInSubsteps(const std::function<bool(int&)>& iterate);
+
+    // full-size objects used by fullSystemIteration, kept between nonlinear
+    // iterations and only resized when the number of cells changes
+    struct SystemWorkspace
+    {
+        SMatrix identity; // couples the fracture pressures into the mechanics equations
+        VectorHP x;
+        VectorHP dx;
+        VectorHP rhs;
+        VectorHP res; // residual and correction of the mixed precision refinement
+        VectorHP ddx;
+        ResVector Ah;
+        ResVector head;
+        std::vector<double> a_diag; // diagonal and absolute row sums of the dense
+        std::vector<double> a_row_sums; // fracture matrix, cleared with the matrix
+    };
+    SystemWorkspace system_workspace_;
+    void resizeSystemWorkspace();
+
     void assembleFractureMatrix() const;
     std::vector<double> stressIntensityK1() const;
     int numWellEquations() const
     {
-        return prm_.get_child("control").get<std::string>("type") == "rate_well" ? 1 : 0;
+        return std::holds_alternative<RateWellControl>(control_) ? 1 : 0;
     }
 
     // double well_pressure_;// for now using prm object for definition
@@ -342,6 +579,8 @@ private:
 
     // only for radom access need to be updater after trid change
     Dune::BlockVector<Dune::FieldVector<double, 3>> cell_normals_;
+    // per-cell geometry of grid_, rebuilt by updateGeometry() whenever the grid changes
+    FractureGeometryCache geometry_;
 
     // solution variables (only to avoid memory allocation, do not trust their state)
     mutable Dune::BlockVector<Dune::FieldVector<double, 1>> fracture_width_;
@@ -349,19 +588,17 @@ private:
     mutable Dune::BlockVector<Dune::FieldVector<double, 1>> fracture_pressure_;
     mutable Dune::BlockVector<Dune::FieldVector<double, 1>> rhs_pressure_;
 
-    // transmissibilities
-    using Htrans = std::tuple<std::size_t, std::size_t, double, double>;
-    std::vector<Htrans> htrans_;
+    // transmissibilities (see FlowConnections)
+    FlowConnections htrans_;
+    MatrixSlots pressure_slots_; // set by initPressureMatrix()
+    MatrixSlots coupling_slots_; // set when coupling_matrix_ is created
     std::vector<std::tuple<int, double>> perfinj_;
     double perf_pressure_;
     std::vector<double> leakof_;
     //
-    PropertyTree prmpressure_;
-    using PressureOperatorType = Dune::MatrixAdapter<Matrix, Vector, Vector>;
-    using FlexibleSolverType = Dune::FlexibleSolver<PressureOperatorType>;
     mutable std::unique_ptr<Matrix> pressure_matrix_;
-    mutable std::unique_ptr<PressureOperatorType> pressure_operator_;
-    mutable std::unique_ptr<FlexibleSolverType> pressure_solver_;
+    // set up for the sparsity of pressure_matrix_ (reset by initPressureMatrix())
+    mutable std::unique_ptr<FracturePressureSolver> pressure_solver_;
     mutable std::unique_ptr<Matrix> coupling_matrix_; // will be updated by `fullSystemIteration`
 
     using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<Grid::LeafGridView>;
@@ -378,13 +615,89 @@ private:
         return *fracture_matrix_;
     }
 
-    double E_;
-    double nu_;
+    // geometry the fracture matrix was assembled for, and the matrix (with its
+    // geometry) from before the last grid change, see invalidateFractureMatrix()
+    mutable ddm::TriangleTable fracture_matrix_tris_;
+    mutable std::unique_ptr<DynamicMatrix> previous_fracture_matrix_;
+    mutable ddm::TriangleTable previous_fracture_matrix_tris_;
+
+    // LU factorization of the fracture matrix, kept until the matrix is invalidated
+    mutable std::unique_ptr<ddm::DenseLU> fracture_matrix_lu_;
+    const ddm::DenseLU& fractureMatrixLU() const
+    {
+        using Precision = ddm::DenseLU::Precision;
+        if (fracture_matrix_lu_ == nullptr)
+            fracture_matrix_lu_ = std::make_unique<ddm::DenseLU>(
+                fractureMatrix(), useSinglePrecision() ? Precision::Single : Precision::Double);
+        return *fracture_matrix_lu_;
+    }
+
+    // single precision copy of the fracture matrix, used by the inner iterations of
+    // the coupled solve if "solver.ddm.precision" is "single"
+    using SingleMatrix = Dune::DynamicMatrix<float>;
+    mutable std::unique_ptr<SingleMatrix> fracture_matrix_single_;
+    bool useSinglePrecision() const
+    {
+        return settings_.single_precision;
+    }
+
+    const SingleMatrix& fractureMatrixSingle() const
+    {
+        if (fracture_matrix_single_ == nullptr) {
+            const auto& A = fractureMatrix();
+            fracture_matrix_single_ = std::make_unique<SingleMatrix>(A.N(), A.M());
+            for (std::size_t i = 0; i != A.N(); ++i) {
+                for (std::size_t j = 0; j != A.M(); ++j) {
+                    (*fracture_matrix_single_)[i][j] = static_cast<float>(A[i][j]);
+                }
+            }
+        }
+        return *fracture_matrix_single_;
+    }
+
+    // compressed alternative to the dense fracture matrix, used if
+    // "solver.ddm.storage" is "hmatrix" or "lattice"
+    mutable std::unique_ptr<ddm::MatrixFreeOperator> fracture_operator_;
+    bool useMatrixFreeOperator() const
+    {
+        return settings_.ddm_storage != "dense";
+    }
+
+    const ddm::MatrixFreeOperator& fractureOperator() const
+    {
+        if (fracture_operator_ == nullptr)
+            assembleFractureOperator();
+        return *fracture_operator_;
+    }
+
+    void assembleFractureOperator() const;
+
+    // tree based evaluation of the fracture induced fields (if "solver.ddm.field.method"
+    // is "tree"), built for the current widths and reused until they change
+    mutable std::unique_ptr<ddm::FieldEvaluator> field_evaluator_;
+    mutable std::vector<double> field_evaluator_widths_;
+    bool useFieldEvaluator() const;
+    const ddm::FieldEvaluator& fieldEvaluator() const;
+
+    std::unique_ptr<ddm::MatrixFreeOperator> makeLatticeOperator(const ddm::TriangleTable& tris) const;
+    // y += A x, with A the fracture matrix in whichever storage is in use
+    void fractureMatrixUmv(const ResVector& x, ResVector& y) const;
+    // drop the mechanics operator(s) and factorization, which must be done whenever the
+    // grid or the elastic parameters change.  Unless 'keep_for_reuse' is false, the
+    // dense matrix is kept so that the entries of unchanged triangles can be reused
+    // when it is assembled for the new grid.
+    void invalidateFractureMatrix(bool keep_for_reuse = true);
+
+    double E_ {0.0}; // 0 until the reservoir properties are known
+    double nu_ {0.0};
     double min_width_; // minimum width of fracture, used for convergence criterion
     double gravity_ {0.0}; //{9.81}; // gravity acceleration, used for leakoff calculations
     std::vector<double> fracture_dgh_; // gravity contribution to fracture pressure, used
                                        // for leakoff calculations
     PropertyTree prm_;
+    // typed copies of "control" and "solver" in prm_, set in init()
+    InjectionControl control_;
+    FractureSolverSettings settings_;
     double total_WI_well_ {0.0}; // total well index for the well, used for leakoff calculations
 };
 
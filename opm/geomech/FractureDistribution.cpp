@@ -0,0 +1,271 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/FractureDistribution.hpp>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+// Flat binary packing of the solve data.  Sender and receiver run the same
+// executable, so the native representation of the values is used.
+class Packer
+{
+public:
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* const p = reinterpret_cast<const char*>(&value);
+        buffer_.insert(buffer_.end(), p, p + sizeof(T));
+    }
+
+    template <typename T>
+    void write(const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(values.size());
+        const auto* const p = reinterpret_cast<const char*>(values.data());
+        buffer_.insert(buffer_.end(), p, p + values.size() * sizeof(T));
+    }
+
+    void write(const std::string& value)
+    {
+        write(std::vector<char>(value.begin(), value.end()));
+    }
+
+    std::vector<char> buffer()
+    {
+        return std::move(buffer_);
+    }
+
+private:
+    std::vector<char> buffer_;
+};
+
+class Unpacker
+{
+public:
+    explicit Unpacker(const std::vector<char>& buffer)
+        : buffer_(buffer)
+    {
+    }
+
+    template <typename T>
+    void read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        readBytes(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void read(std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::size_t size = 0;
+        read(size);
+        if (size > (buffer_.size() - pos_) / sizeof(T)) {
+            OPM_THROW(std::runtime_error, "Truncated fracture solve data");
+        }
+        values.resize(size);
+        readBytes(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+    }
+
+    void read(std::string& value)
+    {
+        std::vector<char> tmp;
+        read(tmp);
+        value.assign(tmp.begin(), tmp.end());
+    }
+
+    void finish() const
+    {
+        if (pos_ != buffer_.size()) {
+            OPM_THROW(std::runtime_error, "Unexpected size of fracture solve data");
+        }
+    }
+
+private:
+    void readBytes(char* const dest, const std::size_t num_bytes)
+    {
+        if (num_bytes > buffer_.size() - pos_) {
+            OPM_THROW(std::runtime_error, "Truncated fracture solve data");
+        }
+        if (num_bytes > 0) {
+            std::memcpy(dest, buffer_.data() + pos_, num_bytes);
+        }
+        pos_ += num_bytes;
+    }
+
+    const std::vector<char>& buffer_;
+    std::size_t pos_ {0};
+};
+
+// applies 'op' to each member, in the same order for packing and unpacking
+template <class Data, class Op>
+void
+forEachMember(Data& d, Op&& op)
+{
+    op(d.well);
+    op(d.perf);
+    op(d.well_cell);
+    op(d.global_index);
+    op(d.segment);
+    op(d.has_perf_range);
+    op(d.perf_range);
+    op(d.origo);
+    op(d.axis);
+    op(d.vertices);
+    op(d.triangles);
+    op(d.well_source);
+    op(d.reservoir_cells);
+    op(d.reservoir_perm);
+    op(d.reservoir_cstress);
+    op(d.reservoir_mobility);
+    op(d.reservoir_density);
+    op(d.reservoir_cell_z);
+    op(d.reservoir_dist);
+    op(d.reservoir_pressure);
+    op(d.reservoir_stress);
+    op(d.filtercake_thickness);
+    op(d.filtercake_perm);
+    op(d.filtercake_poro);
+    op(d.has_filtercake);
+    op(d.E);
+    op(d.nu);
+    op(d.perf_pressure);
+    op(d.total_WI_well);
+    op(d.width);
+    op(d.pressure);
+    op(d.active_set);
+    op(d.warm_start);
+}
+
+template <class Result, class Op>
+void
+forEachResultMember(Result& r, Op&& op)
+{
+    op(r.width);
+    op(r.pressure);
+    op(r.active_set);
+    op(r.warm_start);
+}
+
+} // anonymous namespace
+
+namespace Opm
+{
+std::vector<char>
+packFractureSolveData(const FractureSolveData& data)
+{
+    Packer packer;
+    forEachMember(data, [&packer](const auto& m) { packer.write(m); });
+    return packer.buffer();
+}
+
+FractureSolveData
+unpackFractureSolveData(const std::vector<char>& buffer)
+{
+    FractureSolveData data;
+    Unpacker unpacker(buffer);
+    forEachMember(data, [&unpacker](auto& m) { unpacker.read(m); });
+    unpacker.finish();
+    return data;
+}
+
+std::vector<char>
+packFractureSolveResult(const FractureSolveResult& result)
+{
+    Packer packer;
+    forEachResultMember(result, [&packer](const auto& m) { packer.write(m); });
+    return packer.buffer();
+}
+
+FractureSolveResult
+unpackFractureSolveResult(const std::vector<char>& buffer)
+{
+    FractureSolveResult result;
+    Unpacker unpacker(buffer);
+    forEachResultMember(result, [&unpacker](auto& m) { unpacker.read(m); });
+    unpacker.finish();
+    return result;
+}
+
+double
+fractureSolveCost(const std::size_t num_cells, const double exponent)
+{
+    return std::pow(static_cast<double>(num_cells), exponent);
+}
+
+std::vector<int>
+assignFracturesToRanks(const std::vector<double>& costs,
+                       const std::vector<int>& owners,
+                       const std::vector<char>& movable,
+                       const int num_ranks,
+                       const double tolerance)
+{
+    const std::size_t n = costs.size();
+    if (owners.size() != n || movable.size() != n) {
+        OPM_THROW(std::invalid_argument, "Inconsistent sizes of fracture costs and owners");
+    }
+
+    std::vector<int> result(owners);
+
+    // fractures that cannot be moved load their owner in any case
+    std::vector<double> load(num_ranks, 0.0);
+    std::vector<std::size_t> order;
+    for (std::size_t k = 0; k != n; ++k) {
+        if (movable[k]) {
+            order.push_back(k);
+        } else {
+            load[owners[k]] += costs[k];
+        }
+    }
+
+    // stable, so that ties are broken by the (global) fracture index
+    std::stable_sort(order.begin(), order.end(), [&costs](const std::size_t a, const std::size_t b) {
+        return costs[a] > costs[b];
+    });
+
+    for (const std::size_t k : order) {
+        const int least_loaded
+            = static_cast<int>(std::min_element(load.begin(), load.end()) - load.begin());
+        const int owner = owners[k];
+
+        const int rank = (load[owner] + costs[k] <= (1.0 + tolerance) * (load[least_loaded] + costs[k]))
+            ? owner
+            : least_loaded;
+
+        result[k] = rank;
+        load[rank] += costs[k];
+    }
+
+    return result;
+}
+
+} // namespace Opm
@@ -0,0 +1,115 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FRACTURE_DISTRIBUTION_HPP_INCLUDED
+#define OPM_FRACTURE_DISTRIBUTION_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+// Distribution of the fracture solves over the MPI ranks.  Each rank owns the
+// fractures of its local wells, but the solve of a fracture that does not need the
+// reservoir grid (i.e. is not propagated) can be done by any rank, given the
+// reservoir properties sampled on its cells.  The owner then receives the solution
+// and computes the well indices and leakoff from it.
+
+// everything needed to solve a fracture on a fixed grid on another rank
+struct FractureSolveData
+{
+    // well connection (cf. WellInfo)
+    std::string well;
+    int perf {0};
+    int well_cell {0};
+    int global_index {0};
+    int segment {0};
+    bool has_perf_range {false};
+    std::array<double, 2> perf_range {};
+
+    std::array<double, 3> origo {};
+    std::array<double, 9> axis {};
+
+    // fracture grid: 3 coordinates per vertex and 3 vertices per cell, in the
+    // order of the leaf index sets
+    std::vector<double> vertices;
+    std::vector<unsigned int> triangles;
+    std::vector<int> well_source;
+
+    // reservoir properties, per fracture cell (6 stress components per cell)
+    std::vector<int> reservoir_cells;
+    std::vector<double> reservoir_perm;
+    std::vector<double> reservoir_cstress;
+    std::vector<double> reservoir_mobility;
+    std::vector<double> reservoir_density;
+    std::vector<double> reservoir_cell_z;
+    std::vector<double> reservoir_dist;
+    std::vector<double> reservoir_pressure;
+    std::vector<double> reservoir_stress;
+    std::vector<double> filtercake_thickness;
+    double filtercake_perm {0.0};
+    double filtercake_poro {0.0};
+    bool has_filtercake {false};
+
+    double E {0.0};
+    double nu {0.0};
+    double perf_pressure {0.0};
+    double total_WI_well {0.0};
+
+    // state to continue from
+    std::vector<double> width;
+    std::vector<double> pressure;
+    std::vector<int> active_set;
+    bool warm_start {false};
+};
+
+// solution of a fracture solved on another rank
+struct FractureSolveResult
+{
+    std::vector<double> width;
+    std::vector<double> pressure;
+    std::vector<int> active_set;
+    bool warm_start {false};
+};
+
+std::vector<char> packFractureSolveData(const FractureSolveData& data);
+FractureSolveData unpackFractureSolveData(const std::vector<char>& buffer);
+std::vector<char> packFractureSolveResult(const FractureSolveResult& result);
+FractureSolveResult unpackFractureSolveResult(const std::vector<char>& buffer);
+
+// estimated cost of solving a fracture with 'num_cells' cells, which is between
+// quadratic (iterative solves with the dense fracture matrix) and cubic (its
+// factorization) in the number of cells
+double fractureSolveCost(std::size_t num_cells, double exponent);
+
+// Rank solving each fracture, given its estimated cost, owner rank and whether it
+// may be moved.  The fractures are assigned in order of decreasing cost (longest
+// processing time first), each to the least loaded rank, unless its owner would
+// finish it at most a factor 1 + 'tolerance' later, in which case it stays.  The
+// result is identical on all ranks given identical arguments.
+std::vector<int> assignFracturesToRanks(const std::vector<double>& costs,
+                                        const std::vector<int>& owners,
+                                        const std::vector<char>& movable,
+                                        int num_ranks,
+                                        double tolerance);
+} // namespace Opm
+
+#endif // OPM_FRACTURE_DISTRIBUTION_HPP_INCLUDED
@@ -0,0 +1,83 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/FractureGeometryCache.hpp>
+
+#include <dune/grid/common/mcmgmapper.hh>
+
+#include <cmath>
+#include <cstddef>
+
+namespace Opm
+{
+FractureGeometryCache
+makeFractureGeometryCache(const Dune::FoamGrid<2, 3>& grid)
+{
+    using GridView = Dune::FoamGrid<2, 3>::LeafGridView;
+    using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<GridView>;
+
+    const GridView gv = grid.leafGridView();
+    const ElementMapper mapper(gv, Dune::mcmgElementLayout());
+    const std::size_t nc = gv.size(0);
+
+    FractureGeometryCache geometry;
+    geometry.triangles = ddm::makeTriangleTable(grid);
+    geometry.areas.resize(nc);
+    geometry.neighbors.resize(nc);
+    geometry.boundary_dist.assign(nc, std::nan("0"));
+
+    for (const auto& elem : elements(gv)) {
+        const std::size_t eIdx = mapper.index(elem);
+        const auto geom = elem.geometry();
+        const auto eCenter = geom.center();
+        geometry.areas[eIdx] = geom.volume();
+
+        for (const auto& is : Dune::intersections(gv, elem)) {
+            const auto isCenter = is.geometry().center();
+
+            if (is.boundary()) {
+                geometry.boundary_dist[eIdx] = (isCenter - eCenter).two_norm();
+                continue;
+            }
+
+            const std::size_t nIdx = mapper.index(is.outside());
+            geometry.neighbors[eIdx].push_back(nIdx);
+
+            if (!(eIdx < nIdx)) {
+                continue;
+            }
+
+            // calculate distance between the midpoints
+            const auto nCenter = is.outside().geometry().center();
+            const auto d_inside = eCenter - isCenter;
+            const auto d_outside = nCenter - isCenter;
+
+            // probably should use projected distance
+            const double area = is.geometry().volume();
+            geometry.faces.push_back(
+                {eIdx, nIdx, area / d_inside.two_norm(), area / d_outside.two_norm()});
+        }
+    }
+
+    return geometry;
+}
+
+} // namespace Opm
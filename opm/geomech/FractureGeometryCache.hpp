@@ -0,0 +1,68 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FRACTURE_GEOMETRY_CACHE_HPP_INCLUDED
+#define OPM_FRACTURE_GEOMETRY_CACHE_HPP_INCLUDED
+
+#include <dune/foamgrid/foamgrid.hh>
+
+#include <opm/geomech/DiscreteDisplacement.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+// Flat per-cell geometry of a fracture grid, indexed by the element mapper.  It
+// is rebuilt only when the grid changes, so that the loops in Fracture can read
+// plain arrays instead of walking Dune entities and recomputing geometries.
+struct FractureGeometryCache
+{
+    // interior intersection between cells i < j, with the geometric part of the
+    // transmissibility on each side (edge length over center-to-edge distance)
+    struct Face
+    {
+        std::size_t i {};
+        std::size_t j {};
+        double h_i {};
+        double h_j {};
+    };
+
+    ddm::TriangleTable triangles; // corners, centroids and normals
+    std::vector<double> areas;
+    std::vector<std::vector<std::size_t>> neighbors;
+    std::vector<Face> faces; // in grid traversal order
+    std::vector<double> boundary_dist; // center to boundary edge, NaN for interior cells
+
+    std::size_t size() const
+    {
+        return areas.size();
+    }
+
+    double z(const std::size_t cell) const
+    {
+        return triangles.centers[cell][2];
+    }
+};
+
+FractureGeometryCache makeFractureGeometryCache(const Dune::FoamGrid<2, 3>& grid);
+
+} // namespace Opm
+
+#endif // OPM_FRACTURE_GEOMETRY_CACHE_HPP_INCLUDED
@@ -0,0 +1,117 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/FractureInteraction.hpp>
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/TimingMacros.hpp>
+
+#include <stdexcept>
+
+namespace Opm
+{
+FractureInteraction::FractureInteraction(const std::vector<const ddm::TriangleTable*>& tris,
+                                         const std::vector<double>& E,
+                                         const std::vector<double>& nu,
+                                         const ddm::HMatrix::Params& params)
+    : num_fractures_(tris.size())
+    , num_cells_(tris.size())
+    , blocks_(tris.size() * tris.size())
+{
+    OPM_TIMEFUNCTION();
+
+    if (E.size() != num_fractures_ || nu.size() != num_fractures_) {
+        OPM_THROW(std::invalid_argument, "Elastic parameters missing for interacting fractures");
+    }
+
+    std::vector<std::vector<ddm::HMatrix::Point>> centers(num_fractures_);
+    for (std::size_t f = 0; f != num_fractures_; ++f) {
+        const auto& t = *tris[f];
+        num_cells_[f] = t.size();
+        centers[f].resize(t.size());
+        for (std::size_t c = 0; c != t.size(); ++c) {
+            centers[f][c] = {t.centers[c][0], t.centers[c][1], t.centers[c][2]};
+        }
+    }
+
+    for (std::size_t i = 0; i != num_fractures_; ++i) {
+        for (std::size_t j = 0; j != num_fractures_; ++j) {
+            if (i == j || num_cells_[i] == 0 || num_cells_[j] == 0) {
+                continue;
+            }
+
+            const auto& obs = *tris[i];
+            const auto& src = *tris[j];
+            const double Ei = E[i];
+            const double nui = nu[i];
+            const auto kernel = [&obs, &src, Ei, nui](std::size_t r, std::size_t c) {
+                return ddm::influenceCoefficient(
+                    obs.centers[r], obs.normals[r], src.corners[c], Ei, nui);
+            };
+
+            blocks_[i * num_fractures_ + j]
+                = std::make_unique<ddm::HMatrix>(centers[i], centers[j], kernel, params);
+        }
+    }
+}
+
+void
+FractureInteraction::shadowTraction(const std::size_t i,
+                                    const std::vector<std::vector<double>>& widths,
+                                    std::vector<double>& traction) const
+{
+    OPM_TIMEFUNCTION();
+
+    traction.assign(num_cells_[i], 0.0);
+    for (std::size_t j = 0; j != num_fractures_; ++j) {
+        const auto& block = blocks_[i * num_fractures_ + j];
+        if (block && widths[j].size() == num_cells_[j]) {
+            block->umv(widths[j].data(), traction.data());
+        }
+    }
+}
+
+std::size_t
+FractureInteraction::numStoredValues() const
+{
+    std::size_t result = 0;
+    for (const auto& block : blocks_) {
+        if (block) {
+            result += block->numStoredValues();
+        }
+    }
+    return result;
+}
+
+double
+FractureInteraction::compressionRatio() const
+{
+    double full = 0.0;
+    for (std::size_t i = 0; i != num_fractures_; ++i) {
+        for (std::size_t j = 0; j != num_fractures_; ++j) {
+            if (i != j) {
+                full += static_cast<double>(num_cells_[i]) * num_cells_[j];
+            }
+        }
+    }
+    return full > 0.0 ? numStoredValues() / full : 1.0;
+}
+} // namespace Opm
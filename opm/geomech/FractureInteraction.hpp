@@ -0,0 +1,70 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FRACTURE_INTERACTION_HPP_INCLUDED
+#define OPM_FRACTURE_INTERACTION_HPP_INCLUDED
+
+#include <opm/geomech/DiscreteDisplacement.hpp>
+#include <opm/geomech/HMatrix.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Opm
+{
+// Elastic interaction (stress shadowing) between a group of fractures, e.g. those
+// of one well or pad.  The block (i, j) maps the openings of fracture j to the
+// normal traction they cause on the cells of fracture i.  The off-diagonal blocks
+// are stored as H-matrices, which are mostly low rank since the fractures are
+// separated, so the memory is far below the O((sum N)^2) of a dense operator.  The
+// diagonal blocks are the fracture matrices of the fractures themselves.
+class FractureInteraction
+{
+public:
+    // 'E' and 'nu' are the elastic parameters of each fracture, used for the rows
+    // of the blocks observed on it
+    FractureInteraction(const std::vector<const ddm::TriangleTable*>& tris,
+                        const std::vector<double>& E,
+                        const std::vector<double>& nu,
+                        const ddm::HMatrix::Params& params);
+
+    std::size_t size() const
+    {
+        return num_fractures_;
+    }
+
+    // normal traction on the cells of fracture i caused by the openings 'widths'
+    // of all other fractures (widths of another size than the fracture are ignored)
+    void shadowTraction(std::size_t i,
+                        const std::vector<std::vector<double>>& widths,
+                        std::vector<double>& traction) const;
+
+    std::size_t numStoredValues() const;
+    // stored values divided by those of the dense off-diagonal blocks
+    double compressionRatio() const;
+
+private:
+    std::size_t num_fractures_ {0};
+    std::vector<std::size_t> num_cells_;
+    std::vector<std::unique_ptr<ddm::HMatrix>> blocks_; // row-major, none on the diagonal
+};
+} // namespace Opm
+
+#endif // OPM_FRACTURE_INTERACTION_HPP_INCLUDED
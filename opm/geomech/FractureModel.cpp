@@ -34,12 +34,19 @@
 #include <opm/simulators/wells/WellState.hpp>
 
 #include <opm/geomech/DiscreteDisplacement.hpp>
+#include <opm/geomech/FractureDistribution.hpp>
+#include <opm/geomech/FractureSettings.hpp>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <iostream>
 #include <iterator>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -70,6 +77,22 @@ makeDefaultFractureParam()
     //
     fracture_param.put("fractureparam.reduce_boundary", false);
     fracture_param.put("fractureparam.addconnections", true);
+    // threads used to solve the fractures concurrently (requires OpenMP)
+    fracture_param.put("fractureparam.solve_threads", 1);
+    // with MPI, solve fractures that are not propagated on other ranks than their
+    // owners to balance the estimated cost, num_cells^exponent, between the ranks.
+    // A fracture stays with its owner unless that delays it by more than the tolerance.
+    fracture_param.put("fractureparam.balance_ranks", false);
+    fracture_param.put("fractureparam.balance_cost_exponent", 2.0);
+    fracture_param.put("fractureparam.balance_tolerance", 0.1);
+    // elastic interaction between fractures that are not propagated: "none", "well"
+    // (fractures of the same well) or "all" (all fractures of the rank, e.g. a pad).
+    // Interacting fractures are solved jointly by block Gauss-Seidel until the widths
+    // change less than 'tol' [m]; the interaction blocks use the solver.ddm.hmatrix
+    // parameters.
+    fracture_param.put("fractureparam.coupling.type", "none"s);
+    fracture_param.put("fractureparam.coupling.max_iter", 20);
+    fracture_param.put("fractureparam.coupling.tol", 1e-5);
 
     // very experimental to calculate stress contributions from fracture to cell values
     fracture_param.put("fractureparam.include_fracture_contributions", false);
@@ -96,12 +119,69 @@ makeDefaultFractureParam()
     fracture_param.put("fractureparam.solver.max_dwidth", 5e-3);
     fracture_param.put("fractureparam.solver.max_dp", 1e9);
     fracture_param.put("fractureparam.solver.max_change", 1e5);
+    // history depth of the Anderson acceleration of method "iterative" (0: plain Picard)
+    fracture_param.put("fractureparam.solver.anderson_depth", 5);
     fracture_param.put("fractureparam.solver.verbosity", 0);
+    // start each fracture solve from the previous solution (if it converged on the same
+    // grid, or for trimesh propagation, transferred to the new grid)
+    fracture_param.put("fractureparam.solver.warm_start", false);
+    // step control of the coupled Newton iteration: "none" (fixed 'damping') or
+    // "backtracking" (on the residual, adaptive damping starting from 'damping')
+    fracture_param.put("fractureparam.solver.line_search", "none"s);
+    fracture_param.put("fractureparam.solver.max_backtracks", 6);
+    // assembly of the fracture flow system: "fused" (one pass over the connections) or
+    // "separate" (pressure matrix, sources and coupling matrix one after the other)
+    fracture_param.put("fractureparam.solver.assembly", "fused"s);
+    // closing of fracture cells in method "if": "heuristic" (closed if compressed
+    // with zero width) or "active_set" (primal-dual active set on width >= 0)
+    fracture_param.put("fractureparam.solver.contact", "heuristic"s);
+    // re-solving a fracture whose inputs (traction, reservoir pressure and mobility,
+    // perforation pressure and filter cake) changed less than 'reuse_tol' relative to
+    // the last full solve is skipped, and less than 'correction_tol' only takes one
+    // Newton step with method "if" (0: always a full solve)
+    fracture_param.put("fractureparam.solver.reuse_tol", 0.0);
+    fracture_param.put("fractureparam.solver.correction_tol", 0.0);
+    // sub-stepping of method "if": "none" or "adaptive" (inputs interpolated from the
+    // last solve, starting with one step, halved down to 'min_substep' if the
+    // iteration fails and grown towards 'substep_target_iter' iterations per sub-step)
+    fracture_param.put("fractureparam.solver.substeps", "none"s);
+    fracture_param.put("fractureparam.solver.min_substep", 1.0 / 64);
+    fracture_param.put("fractureparam.solver.substep_target_iter", 8);
+
+    // assembly of the DDM (mechanics) matrix; threads only take effect with OpenMP
+    fracture_param.put("fractureparam.solver.ddm.num_threads", 1);
+    // reuse entries of unchanged triangles when the (dense) matrix is rebuilt after a grid change
+    fracture_param.put("fractureparam.solver.ddm.incremental", true);
+    // storage of the DDM matrix: "dense", "hmatrix" (compressed, O(N log N)) or
+    // "lattice" (translation invariant kernel on RegularTrimesh grids, FFT based)
+    fracture_param.put("fractureparam.solver.ddm.storage", "dense"s);
+    fracture_param.put("fractureparam.solver.ddm.hmatrix.tol", 1e-6);
+    fracture_param.put("fractureparam.solver.ddm.hmatrix.leaf_size", 32);
+    fracture_param.put("fractureparam.solver.ddm.hmatrix.eta", 2.0);
+    // evaluation of fracture induced strain/stress/displacement at reservoir cells:
+    // "direct" (sum over all fracture cells) or "tree" (cluster tree with interpolated
+    // far field, O((N + M) log(N + M)) for N fracture cells and M points)
+    fracture_param.put("fractureparam.solver.ddm.field.method", "direct"s);
+    fracture_param.put("fractureparam.solver.ddm.field.order", 6);
+    fracture_param.put("fractureparam.solver.ddm.field.eta", 2.0);
+    fracture_param.put("fractureparam.solver.ddm.field.leaf_size", 32);
+    // precision of the dense DDM matrix factors and coupled inner iterations: "double" or
+    // "single" (half the memory, double accuracy recovered by iterative refinement)
+    fracture_param.put("fractureparam.solver.ddm.precision", "double"s);
+    fracture_param.put("fractureparam.solver.ddm.refinement.tol", 1e-12);
+    fracture_param.put("fractureparam.solver.ddm.refinement.max_iter", 10);
 
     // fracture linear solve
     fracture_param.put("fractureparam.solver.linsolver.tol", 1e-10);
     fracture_param.put("fractureparam.solver.linsolver.max_iter", 1000);
     fracture_param.put("fractureparam.solver.linsolver.verbosity", 0);
+    // preconditioner of the coupled width/pressure system: "diag" or "schur" (block LDU with
+    // the factorized fracture matrix, dense storage only).  The flow Schur complement is
+    // either formed exactly ("dense") or approximated by M - C diag(A)^-1 I ("sparse"),
+    // which is solved by 'schur_solver'
+    fracture_param.put("fractureparam.solver.linsolver.preconditioner", "diag"s);
+    fracture_param.put("fractureparam.solver.linsolver.schur", "dense"s);
+    fracture_param.put("fractureparam.solver.linsolver.schur_solver", "umfpack"s);
 
     // reservoir fracture coupling
     fracture_param.put("fractureparam.reservoir.dist", 1e0);
@@ -119,12 +199,29 @@ makeDefaultFractureParam()
     fracture_param.put("fractureparam.fractureWI", 0.1);
     fracture_param.put("fractureparam.write_pressure_system", false);
     fracture_param.put("fractureparam.write_fracture_system", false);
-    fracture_param.put("fractureparam.pressuresolver", "umfpack"s);
+    // "direct" (UMFPACK, reusing the ordering), "amg" (reusing the aggregates) or a
+    // FlexibleSolver linear solver such as "umfpack" or "ilu0"
+    fracture_param.put("fractureparam.pressuresolver", "direct"s);
+    fracture_param.put("fractureparam.pressuresolver_tol", 1e-10);
+    fracture_param.put("fractureparam.pressuresolver_max_iter", 200);
+    fracture_param.put("fractureparam.pressuresolver_verbosity", 0);
     fracture_param.put("fractureparam.fracturesolver", "notused"s);
 
     return fracture_param;
 }
 
+FractureModel::~FractureModel()
+{
+#if HAVE_MPI
+    // the model may outlive MPI
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (exchange_comm_ != MPI_COMM_NULL && !finalized) {
+        MPI_Comm_free(&exchange_comm_);
+    }
+#endif
+}
+
 void
 FractureModel::addWell(const std::string& name,
                        const std::vector<FractureWell::Connection>& conns,
@@ -223,6 +320,80 @@ FractureModel::disp(const Dune::FieldVector<double, 3>& obs) const
     return disp;
 }
 
+std::vector<Dune::FieldVector<double, 6>>
+FractureModel::stress(const std::vector<Dune::FieldVector<double, 3>>& obs) const
+{
+    std::vector<Dune::FieldVector<double, 6>> stress(obs.size(), 0.0);
+
+    for (const auto& fractures : this->well_fractures_) {
+        for (const auto& fracture : fractures) {
+            const auto frac_stress = fracture.stress(obs);
+            for (std::size_t i = 0; i != obs.size(); ++i) {
+                stress[i] += frac_stress[i];
+            }
+        }
+    }
+
+    return stress;
+}
+
+std::vector<Dune::FieldVector<double, 6>>
+FractureModel::strain(const std::vector<Dune::FieldVector<double, 3>>& obs) const
+{
+    std::vector<Dune::FieldVector<double, 6>> strain(obs.size(), 0.0);
+
+    for (const auto& fractures : this->well_fractures_) {
+        for (const auto& fracture : fractures) {
+            const auto frac_strain = fracture.strain(obs);
+            for (std::size_t i = 0; i != obs.size(); ++i) {
+                strain[i] += frac_strain[i];
+            }
+        }
+    }
+
+    return strain;
+}
+
+std::vector<Dune::FieldVector<double, 3>>
+FractureModel::disp(const std::vector<Dune::FieldVector<double, 3>>& obs) const
+{
+    std::vector<Dune::FieldVector<double, 3>> disp(obs.size(), 0.0);
+
+    for (const auto& fractures : this->well_fractures_) {
+        for (const auto& fracture : fractures) {
+            const auto frac_disp = fracture.disp(obs);
+            for (std::size_t i = 0; i != obs.size(); ++i) {
+                disp[i] += frac_disp[i];
+            }
+        }
+    }
+
+    return disp;
+}
+
+void
+FractureModel::fields(const std::vector<Dune::FieldVector<double, 3>>& obs,
+                      std::vector<Dune::FieldVector<double, 3>>& disp,
+                      std::vector<Dune::FieldVector<double, 6>>& strain,
+                      std::vector<Dune::FieldVector<double, 6>>& stress) const
+{
+    disp.assign(obs.size(), 0.0);
+    strain.assign(obs.size(), 0.0);
+    stress.assign(obs.size(), 0.0);
+
+    for (const auto& fractures : this->well_fractures_) {
+        for (const auto& fracture : fractures) {
+            const auto frac_disp = fracture.disp(obs);
+            const auto frac_strain = fracture.strain(obs);
+            for (std::size_t i = 0; i != obs.size(); ++i) {
+                disp[i] += frac_disp[i];
+                strain[i] += frac_strain[i];
+                stress[i] += fracture.strainToStress(frac_strain[i]);
+            }
+        }
+    }
+}
+
 void
 FractureModel::write(const int reportStep) const
 {
@@ -257,6 +428,286 @@ FractureModel::writemulti(const double time) const
     }
 }
 
+std::vector<Fracture*>
+FractureModel::updateCoupledGroups(const std::vector<Fracture*>& fractures)
+{
+    const auto type = prm_.get<std::string>("coupling.type", "none");
+
+    const auto is_candidate = [&fractures](const Fracture& fracture) {
+        return fracture.solvesOnFixedGrid()
+            && std::find(fractures.begin(), fractures.end(), &fracture) != fractures.end();
+    };
+
+    std::vector<std::vector<Fracture*>> groups;
+    if (type == "well") {
+        for (auto& well_fractures : well_fractures_) {
+            auto& group = groups.emplace_back();
+            for (auto& fracture : well_fractures) {
+                if (is_candidate(fracture)) {
+                    group.push_back(&fracture);
+                }
+            }
+        }
+    } else if (type == "all") {
+        auto& group = groups.emplace_back();
+        for (auto* fracture : fractures) {
+            if (is_candidate(*fracture)) {
+                group.push_back(fracture);
+            }
+        }
+    } else {
+        OPM_THROW(std::runtime_error, "Unknown fracture coupling type: " + type);
+    }
+
+    const auto settings = makeFractureSolverSettings(prm_.get_child("solver"));
+    ddm::HMatrix::Params params;
+    params.tol = settings.hmatrix_tol;
+    params.leaf_size = settings.hmatrix_leaf_size;
+    params.eta = settings.hmatrix_eta;
+    params.num_threads = settings.ddm_threads;
+
+    std::vector<CoupledGroup> coupled_groups;
+    for (auto& group : groups) {
+        if (group.size() < 2) {
+            continue;
+        }
+
+        std::vector<int> grid_revisions;
+        std::vector<double> elastic_params;
+        for (const auto* fracture : group) {
+            grid_revisions.push_back(fracture->gridRevision());
+            elastic_params.push_back(fracture->youngsModulus());
+            elastic_params.push_back(fracture->poissonsRatio());
+        }
+
+        auto pos = std::find_if(coupled_groups_.begin(), coupled_groups_.end(), [&](const auto& g) {
+            return g.interaction != nullptr && g.fractures == group && g.grid_revisions == grid_revisions
+                && g.elastic_params == elastic_params;
+        });
+        if (pos != coupled_groups_.end()) {
+            coupled_groups.push_back(std::move(*pos));
+            continue;
+        }
+
+        std::vector<const ddm::TriangleTable*> tris;
+        std::vector<double> E;
+        std::vector<double> nu;
+        for (const auto* fracture : group) {
+            tris.push_back(&fracture->triangles());
+            E.push_back(fracture->youngsModulus());
+            nu.push_back(fracture->poissonsRatio());
+        }
+
+        auto& coupled = coupled_groups.emplace_back();
+        coupled.fractures = group;
+        coupled.grid_revisions = std::move(grid_revisions);
+        coupled.elastic_params = std::move(elastic_params);
+        coupled.interaction = std::make_unique<FractureInteraction>(tris, E, nu, params);
+
+        std::cout << "Fracture interaction of " << group.size() << " fractures, compression "
+                  << coupled.interaction->compressionRatio() << std::endl;
+    }
+    coupled_groups_ = std::move(coupled_groups);
+
+    // fractures that are no longer coupled lose the shadow of their former partners
+    std::vector<Fracture*> others;
+    for (auto* fracture : fractures) {
+        const auto in_group = [fracture](const CoupledGroup& g) {
+            return std::find(g.fractures.begin(), g.fractures.end(), fracture) != g.fractures.end();
+        };
+        if (std::none_of(coupled_groups_.begin(), coupled_groups_.end(), in_group)) {
+            fracture->setShadowTraction({});
+            others.push_back(fracture);
+        }
+    }
+
+    return others;
+}
+
+void
+FractureModel::updateShadowTraction(const CoupledGroup& group, const std::size_t k) const
+{
+    std::vector<std::vector<double>> widths;
+    for (const auto* fracture : group.fractures) {
+        const auto& width = fracture->fractureWidth();
+        widths.emplace_back(width.begin(), width.end());
+    }
+
+    std::vector<double> traction;
+    group.interaction->shadowTraction(k, widths, traction);
+    group.fractures[k]->setShadowTraction(std::move(traction));
+}
+
+FractureModel::FractureExchange
+FractureModel::sendFractures(std::vector<Fracture*>& fractures,
+                            const Parallel::Communication& comm) const
+{
+    FractureExchange exchange;
+
+#if HAVE_MPI
+    const int rank = comm.rank();
+    const int num_ranks = comm.size();
+
+    // cost and whether it can be moved, for each local fracture.  Skipped solves
+    // cost nothing, and only full solves are moved, since the inputs of the last
+    // solve are only known to the owner.
+    const double exponent = prm_.get<double>("balance_cost_exponent", 2.0);
+    std::vector<double> local;
+    for (const auto* fracture : fractures) {
+        const FractureSolveKind kind = fracture->plannedSolve();
+        const double cost = fractureSolveCost(fracture->numFractureCells(), exponent);
+        local.push_back(kind == FractureSolveKind::Skipped ? 0.0 : cost);
+        local.push_back(kind == FractureSolveKind::Full && fracture->solvesOnFixedGrid() ? 1.0 : 0.0);
+    }
+
+    const int local_size = local.size();
+    std::vector<int> sizes(num_ranks);
+    comm.allgather(&local_size, 1, sizes.data());
+    std::vector<int> offsets(num_ranks + 1, 0);
+    std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+    std::vector<double> all(offsets.back());
+    comm.allgatherv(local.data(), local_size, all.data(), sizes.data(), offsets.data());
+
+    std::vector<double> costs;
+    std::vector<int> owners;
+    std::vector<char> movable;
+    std::vector<int> owner_index; // index of the fracture on its owner
+    for (int r = 0; r < num_ranks; ++r) {
+        for (int k = offsets[r]; k < offsets[r + 1]; k += 2) {
+            costs.push_back(all[k]);
+            movable.push_back(all[k + 1] != 0.0);
+            owners.push_back(r);
+            owner_index.push_back((k - offsets[r]) / 2);
+        }
+    }
+
+    const auto assignment = assignFracturesToRanks(
+        costs, owners, movable, num_ranks, prm_.get<double>("balance_tolerance", 0.1));
+
+    // the tags of a fracture are 2 * (index on its owner) for the data, and one more
+    // for the solution
+    MPI_Comm mpi_comm = exchange_comm_;
+    std::vector<std::vector<char>> buffers;
+    std::vector<Fracture*> kept;
+    for (std::size_t k = 0; k != assignment.size(); ++k) {
+        if (owners[k] != rank) {
+            continue;
+        }
+
+        auto* fracture = fractures[owner_index[k]];
+        if (assignment[k] == rank) {
+            kept.push_back(fracture);
+            continue;
+        }
+
+        exchange.sent.push_back(fracture);
+        exchange.sent_to.push_back(assignment[k]);
+        exchange.sent_tag.push_back(2 * owner_index[k]);
+        buffers.push_back(packFractureSolveData(fracture->solveData()));
+    }
+
+    std::vector<MPI_Request> requests(buffers.size());
+    for (std::size_t i = 0; i != buffers.size(); ++i) {
+        MPI_Isend(buffers[i].data(),
+                  buffers[i].size(),
+                  MPI_CHAR,
+                  exchange.sent_to[i],
+                  exchange.sent_tag[i],
+                  mpi_comm,
+                  &requests[i]);
+    }
+
+    for (std::size_t k = 0; k != assignment.size(); ++k) {
+        if (assignment[k] != rank || owners[k] == rank) {
+            continue;
+        }
+
+        const int tag = 2 * owner_index[k];
+        MPI_Status status;
+        MPI_Probe(owners[k], tag, mpi_comm, &status);
+        int count = 0;
+        MPI_Get_count(&status, MPI_CHAR, &count);
+        std::vector<char> buffer(count);
+        MPI_Recv(buffer.data(), count, MPI_CHAR, owners[k], tag, mpi_comm, MPI_STATUS_IGNORE);
+
+        exchange.received.emplace_back().initFromSolveData(unpackFractureSolveData(buffer), prm_);
+        exchange.received_from.push_back(owners[k]);
+        exchange.received_tag.push_back(tag);
+    }
+
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    if (!exchange.sent.empty() || !exchange.received.empty()) {
+        std::cout << "Rank " << rank << ": solving " << exchange.received.size()
+                  << " fractures of other ranks, " << exchange.sent.size()
+                  << " fractures solved elsewhere" << std::endl;
+    }
+
+    // moving 'exchange' keeps the received fractures in place
+    fractures = kept;
+    for (auto& fracture : exchange.received) {
+        fractures.push_back(&fracture);
+    }
+#else
+    static_cast<void>(fractures);
+    static_cast<void>(comm);
+#endif
+
+    return exchange;
+}
+
+void
+FractureModel::returnFractures(FractureExchange& exchange) const
+{
+#if HAVE_MPI
+    MPI_Comm mpi_comm = exchange_comm_;
+
+    std::vector<std::vector<char>> buffers;
+    for (const auto& fracture : exchange.received) {
+        buffers.push_back(packFractureSolveResult(fracture.solveResult()));
+    }
+
+    std::vector<MPI_Request> requests(buffers.size());
+    for (std::size_t i = 0; i != buffers.size(); ++i) {
+        MPI_Isend(buffers[i].data(),
+                  buffers[i].size(),
+                  MPI_CHAR,
+                  exchange.received_from[i],
+                  exchange.received_tag[i] + 1,
+                  mpi_comm,
+                  &requests[i]);
+    }
+
+    for (std::size_t i = 0; i != exchange.sent.size(); ++i) {
+        const int tag = exchange.sent_tag[i] + 1;
+        MPI_Status status;
+        MPI_Probe(exchange.sent_to[i], tag, mpi_comm, &status);
+        int count = 0;
+        MPI_Get_count(&status, MPI_CHAR, &count);
+        std::vector<char> buffer(count);
+        MPI_Recv(buffer.data(), count, MPI_CHAR, exchange.sent_to[i], tag, mpi_comm, MPI_STATUS_IGNORE);
+
+        exchange.sent[i]->setSolveResult(unpackFractureSolveResult(buffer));
+    }
+
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+#else
+    static_cast<void>(exchange);
+#endif
+}
+
+FractureSolveStatistics
+FractureModel::solveStatistics() const
+{
+    FractureSolveStatistics statistics;
+    for (const auto& fractures : well_fractures_) {
+        for (const auto& fracture : fractures) {
+            statistics += fracture.solveStatistics();
+        }
+    }
+    return statistics;
+}
+
 void
 FractureModel::updateReservoirProperties()
 {
@@ -29,17 +29,28 @@
 #include <opm/input/eclipse/Schedule/Well/WellConnections.hpp>
 
 #include <opm/simulators/linalg/PropertyTree.hpp>
+#include <opm/simulators/utils/ParallelCommunication.hpp>
 
 #include <opm/geomech/Fracture.hpp>
+#include <opm/geomech/FractureInteraction.hpp>
 #include <opm/geomech/FractureWell.hpp>
 #include <opm/geomech/GeometryHelpers.hpp>
 
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
+#include <exception>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Opm
@@ -64,6 +75,10 @@ public:
 
     template <class Grid>
     FractureModel(const Grid& grid, const std::vector<Well>& wells, const PropertyTree&);
+    ~FractureModel();
+
+    FractureModel(const FractureModel&) = delete;
+    FractureModel& operator=(const FractureModel&) = delete;
 
     /// Initialise fracture objects.
     ///
@@ -109,16 +124,49 @@ public:
     template <class TypeTag, class Simulator>
     void solve(const Simulator& simulator)
     {
-        for (auto& fractures : this->well_fractures_) {
-            for (auto& fracture : fractures) {
+        std::vector<Fracture*> fractures;
+        for (auto& well_fractures : this->well_fractures_) {
+            for (auto& fracture : well_fractures) {
                 if (fracture.isActive()) {
-                    std::cout << "Solving fracture " << fracture.name() << std::endl;
-                    fracture.template solve<TypeTag>(cell_search_tree_, simulator);
+                    fractures.push_back(&fracture);
                 }
             }
         }
+
+        // fractures interacting with others are solved jointly first
+        if (prm_.get<std::string>("coupling.type", "none") != "none") {
+            fractures = this->updateCoupledGroups(fractures);
+            this->solveCoupled<TypeTag>(simulator);
+        }
+
+        const auto& comm = simulator.vanguard().grid().comm();
+        if (!prm_.get<bool>("balance_ranks", false) || comm.size() == 1) {
+            this->solveFractures<TypeTag>(fractures, simulator);
+            return;
+        }
+
+        // fractures on a fixed grid may be solved by other ranks, which return the
+        // solutions to the owners.  The solutions are returned even if a solve
+        // failed, so that no rank is left waiting for them.
+        auto exchange = this->sendFractures(fractures, comm);
+
+        std::exception_ptr error;
+        try {
+            this->solveFractures<TypeTag>(fractures, simulator);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        this->returnFractures(exchange);
+        if (error) {
+            std::rethrow_exception(error);
+        }
     }
 
+    // number of solves of the fractures of this rank so far, by kind (solves done on
+    // other ranks for these fractures included)
+    FractureSolveStatistics solveStatistics() const;
+
     void updateReservoirProperties();
     void initFractureStates();
 
@@ -163,6 +211,21 @@ public:
     Dune::FieldVector<double, 6> strain(const Dune::FieldVector<double, 3>& obs) const;
     Dune::FieldVector<double, 3> disp(const Dune::FieldVector<double, 3>& obs) const;
 
+    // fields at many points at once, using the batched kernels
+    std::vector<Dune::FieldVector<double, 6>>
+    stress(const std::vector<Dune::FieldVector<double, 3>>& obs) const;
+    std::vector<Dune::FieldVector<double, 6>>
+    strain(const std::vector<Dune::FieldVector<double, 3>>& obs) const;
+    std::vector<Dune::FieldVector<double, 3>>
+    disp(const std::vector<Dune::FieldVector<double, 3>>& obs) const;
+
+    // displacement, strain and stress at 'obs' in one pass (the strain is
+    // only evaluated once for each fracture)
+    void fields(const std::vector<Dune::FieldVector<double, 3>>& obs,
+                std::vector<Dune::FieldVector<double, 3>>& disp,
+                std::vector<Dune::FieldVector<double, 6>>& strain,
+                std::vector<Dune::FieldVector<double, 6>>& stress) const;
+
     PropertyTree& getParam()
     {
         return prm_;
@@ -171,6 +234,152 @@ public:
 private:
     bool vtkwritewells_ = false; // write wells to VTK files
 
+    // solve the given fractures, concurrently if "solve_threads" > 1
+    template <class TypeTag, class Simulator>
+    void solveFractures(const std::vector<Fracture*>& fractures, const Simulator& simulator)
+    {
+#ifdef _OPENMP
+        const int num_threads = prm_.get<int>("solve_threads", 1);
+#else
+        const int num_threads = 1;
+#endif
+        if (num_threads <= 1 || fractures.size() < 2) {
+            for (auto* fracture : fractures) {
+                std::cout << "Solving fracture " << fracture->name() << std::endl;
+                fracture->template solve<TypeTag>(cell_search_tree_, simulator);
+            }
+            return;
+        }
+
+        // the fractures are independent once the reservoir properties are gathered,
+        // and are solved concurrently, the most expensive first (the cost of the
+        // dense fracture systems grows with the square of the number of cells).
+        // The output of each fracture is buffered and written in the usual order
+        // once all are solved, and the debug dumps to shared files are off.
+        std::vector<std::pair<double, std::size_t>> order;
+        for (std::size_t i = 0; i != fractures.size(); ++i) {
+            const double num_cells = fractures[i]->numFractureCells();
+            order.emplace_back(-num_cells * num_cells, i);
+        }
+        std::sort(order.begin(), order.end());
+
+        std::vector<std::ostringstream> output(fractures.size());
+        std::vector<std::exception_ptr> errors(fractures.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+#endif
+        for (std::size_t k = 0; k < order.size(); ++k) {
+            const std::size_t i = order[k].second;
+            auto& fracture = *fractures[i];
+
+            fracture.setOutputStream(output[i]);
+            fracture.setDebugDumps(false);
+            try {
+                output[i] << "Solving fracture " << fracture.name() << '\n';
+                fracture.template solve<TypeTag>(cell_search_tree_, simulator);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+            fracture.setOutputStream(std::cout);
+            fracture.setDebugDumps(true);
+        }
+
+        for (std::size_t i = 0; i != fractures.size(); ++i) {
+            std::cout << output[i].str() << std::flush;
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    // Groups of fractures solved jointly ("coupling.type" is "well" or "all"), with
+    // their elastic interaction.  The interaction is kept as long as the fractures,
+    // their grids and elastic parameters are unchanged.
+    struct CoupledGroup
+    {
+        std::vector<Fracture*> fractures;
+        std::vector<int> grid_revisions;
+        std::vector<double> elastic_params;
+        std::unique_ptr<FractureInteraction> interaction;
+    };
+    std::vector<CoupledGroup> coupled_groups_;
+
+    // set up the coupled groups among 'fractures', and return the other fractures
+    std::vector<Fracture*> updateCoupledGroups(const std::vector<Fracture*>& fractures);
+    // set the shadow traction of fracture k of 'group' from the widths of the others
+    void updateShadowTraction(const CoupledGroup& group, std::size_t k) const;
+
+    // Solve the coupled groups by block Gauss-Seidel: each fracture is solved with
+    // the traction caused by the current openings of the others, until the widths
+    // change less than "coupling.tol" in a sweep
+    template <class TypeTag, class Simulator>
+    void solveCoupled(const Simulator& simulator)
+    {
+        const int max_iter = prm_.get<int>("coupling.max_iter", 20);
+        const double tol = prm_.get<double>("coupling.tol", 1e-5);
+
+        for (const auto& group : coupled_groups_) {
+            int sweep = 0;
+            double max_change = 0.0;
+            while (sweep++ < max_iter) {
+                max_change = 0.0;
+                for (std::size_t k = 0; k != group.fractures.size(); ++k) {
+                    auto& fracture = *group.fractures[k];
+                    const Fracture::Vector width = fracture.fractureWidth();
+
+                    this->updateShadowTraction(group, k);
+                    std::cout << "Solving fracture " << fracture.name() << std::endl;
+                    fracture.template solve<TypeTag>(cell_search_tree_, simulator);
+
+                    const auto& new_width = fracture.fractureWidth();
+                    if (new_width.size() != width.size()) {
+                        max_change = std::numeric_limits<double>::infinity();
+                        continue;
+                    }
+                    for (std::size_t i = 0; i != width.size(); ++i) {
+                        max_change = std::max(max_change, std::abs(new_width[i][0] - width[i][0]));
+                    }
+                }
+
+                if (max_change < tol) {
+                    break;
+                }
+            }
+
+            std::cout << "Coupled solve of " << group.fractures.size() << " fractures: "
+                      << std::min(sweep, max_iter) << " sweeps, max width change " << max_change
+                      << (max_change < tol ? "" : " (not converged)") << std::endl;
+        }
+    }
+
+    // fractures solved on other ranks than their owners, see solve()
+    struct FractureExchange
+    {
+        std::vector<Fracture*> sent; // local fractures solved elsewhere
+        std::vector<int> sent_to;
+        std::vector<int> sent_tag;
+        std::vector<Fracture> received; // fractures of other ranks solved here
+        std::vector<int> received_from;
+        std::vector<int> received_tag;
+    };
+
+    // assign the fractures of all ranks to ranks by their estimated costs, and send
+    // the data of the local fractures solved elsewhere.  On return, 'fractures'
+    // holds the fractures to solve on this rank.
+    FractureExchange sendFractures(std::vector<Fracture*>& fractures,
+                                   const Parallel::Communication& comm) const;
+    // send the solutions of the received fractures back to their owners
+    void returnFractures(FractureExchange& exchange) const;
+
+#if HAVE_MPI
+    // duplicate of the grid communicator for the point-to-point messages of
+    // sendFractures() and returnFractures(), so that they cannot match other traffic
+    MPI_Comm exchange_comm_ {MPI_COMM_NULL};
+#endif
+
     template <class TypeTag, class Simulator>
     void updateReservoirProperties(const Simulator& simulator)
     {
@@ -11,6 +11,10 @@ template <class Grid>
 FractureModel::FractureModel(const Grid& grid, const std::vector<Well>& wells, const PropertyTree& param)
     : prm_(param)
 {
+#if HAVE_MPI
+    MPI_Comm_dup(grid.comm(), &exchange_comm_);
+#endif
+
     GeometryHelper geomhelp(grid);
 
     // NB: need to be carefull in parallel
@@ -0,0 +1,242 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/FracturePressureSolver.hpp>
+
+#include <dune/istl/solvers.hh>
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/TimingMacros.hpp>
+
+#include <opm/simulators/linalg/FlowLinearSolverParameters.hpp>
+#include <opm/simulators/linalg/setupPropertyTree.hpp>
+
+#if HAVE_SUITESPARSE_UMFPACK
+#include <umfpack.h>
+#endif
+
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace Opm
+{
+FracturePressureSolver::FracturePressureSolver(const std::string& method,
+                                               const double tol,
+                                               const int max_iter,
+                                               const int verbosity)
+    : method_(method)
+    , tol_(tol)
+    , max_iter_(max_iter)
+    , verbosity_(verbosity)
+{
+#if !HAVE_SUITESPARSE_UMFPACK
+    if (method_ == "direct") {
+        OPM_THROW(std::runtime_error, "Fracture pressure solver 'direct' requires UMFPACK");
+    }
+#endif
+}
+
+FracturePressureSolver::~FracturePressureSolver()
+{
+    freeFactors();
+}
+
+void
+FracturePressureSolver::freeFactors()
+{
+#if HAVE_SUITESPARSE_UMFPACK
+    if (numeric_) {
+        umfpack_di_free_numeric(&numeric_);
+    }
+    if (symbolic_) {
+        umfpack_di_free_symbolic(&symbolic_);
+    }
+#endif
+    numeric_ = nullptr;
+    symbolic_ = nullptr;
+}
+
+void
+FracturePressureSolver::setMatrix(const Matrix& A)
+{
+    OPM_TIMEFUNCTION();
+
+    matrix_ = &A;
+    operator_ = std::make_unique<Operator>(A);
+    amg_.reset();
+    flexible_.reset();
+    freeFactors();
+
+    if (method_ == "direct") {
+#if HAVE_SUITESPARSE_UMFPACK
+        // the rows of A are the columns of A^T, which is what UMFPACK factorizes
+        const int n = static_cast<int>(A.N());
+        col_start_.assign(n + 1, 0);
+        row_index_.clear();
+        row_index_.reserve(A.nonzeroes());
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                row_index_.push_back(static_cast<int>(col.index()));
+            }
+            col_start_[row.index() + 1] = static_cast<int>(row_index_.size());
+        }
+        copyValues();
+
+        const int status = umfpack_di_symbolic(
+            n, n, col_start_.data(), row_index_.data(), values_.data(), &symbolic_, nullptr, nullptr);
+        if (status != UMFPACK_OK) {
+            OPM_THROW(std::runtime_error,
+                      "Symbolic factorization of fracture pressure matrix failed with status "
+                          + std::to_string(status));
+        }
+        factorNumeric();
+#endif
+    } else if (method_ == "amg") {
+        using Norm = Dune::Amg::FirstDiagonal;
+        using Criterion = Dune::Amg::CoarsenCriterion<Dune::Amg::SymmetricCriterion<Matrix, Norm>>;
+        Criterion criterion;
+        criterion.setDefaultValuesIsotropic(2);
+        criterion.setDebugLevel(0);
+
+        typename Dune::Amg::SmootherTraits<Smoother>::Arguments smoother_args;
+        smoother_args.iterations = 1;
+        smoother_args.relaxationFactor = 1.0;
+
+        amg_ = std::make_unique<AMG>(*operator_, criterion, smoother_args);
+    } else {
+        setupFlexibleSolver();
+    }
+}
+
+void
+FracturePressureSolver::setupFlexibleSolver()
+{
+    Opm::FlowLinearSolverParameters p;
+    p.linsolver_ = method_;
+    flexible_prm_ = Opm::setupPropertyTree(p, true, true);
+
+    const std::size_t pressureIndex = 0; // Dummy
+    const std::function<Vector()> weightsCalculator; // Dummy
+
+    flexible_ = std::make_unique<FlexibleSolverType>(
+        *operator_, flexible_prm_, weightsCalculator, pressureIndex);
+}
+
+void
+FracturePressureSolver::copyValues()
+{
+    values_.resize(row_index_.size());
+    std::size_t k = 0;
+    for (auto row = matrix_->begin(); row != matrix_->end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            values_[k++] = (*col)[0][0];
+        }
+    }
+    assert(k == values_.size());
+}
+
+void
+FracturePressureSolver::factorNumeric()
+{
+#if HAVE_SUITESPARSE_UMFPACK
+    if (numeric_) {
+        umfpack_di_free_numeric(&numeric_);
+    }
+
+    const int status = umfpack_di_numeric(
+        col_start_.data(), row_index_.data(), values_.data(), symbolic_, &numeric_, nullptr, nullptr);
+    if (status == UMFPACK_WARNING_singular_matrix) {
+        *output_ << "Warning: fracture pressure matrix is singular" << std::endl;
+    } else if (status != UMFPACK_OK) {
+        OPM_THROW(std::runtime_error,
+                  "Numeric factorization of fracture pressure matrix failed with status "
+                      + std::to_string(status));
+    }
+#endif
+}
+
+void
+FracturePressureSolver::updateValues()
+{
+    OPM_TIMEFUNCTION();
+    assert(matrix_);
+
+    if (method_ == "direct") {
+        copyValues();
+        factorNumeric();
+    } else if (method_ == "amg") {
+        amg_->recalculateHierarchy();
+    } else if (flexible_prm_.get<std::string>("solver", "") == "umfpack") {
+        // the factorization is computed when the solver is constructed
+        setupFlexibleSolver();
+    } else {
+        flexible_->preconditioner().update();
+    }
+}
+
+void
+FracturePressureSolver::solve(Vector& x, const Vector& b)
+{
+    OPM_TIMEFUNCTION();
+    assert(matrix_);
+
+    x.resize(b.size());
+    x = 0;
+
+#if HAVE_SUITESPARSE_UMFPACK
+    if (method_ == "direct") {
+        // A^T is factorized, so solve the transposed system
+        const int status = umfpack_di_solve(UMFPACK_At,
+                                            col_start_.data(),
+                                            row_index_.data(),
+                                            values_.data(),
+                                            &x[0][0],
+                                            &b[0][0],
+                                            numeric_,
+                                            nullptr,
+                                            nullptr);
+        if (status != UMFPACK_OK && status != UMFPACK_WARNING_singular_matrix) {
+            OPM_THROW(std::runtime_error,
+                      "Solve with fracture pressure matrix failed with status "
+                          + std::to_string(status));
+        }
+        return;
+    }
+#endif
+
+    auto rhs = b; // will be modified by the solver
+    Dune::InverseOperatorResult res {};
+    if (method_ == "amg") {
+        Dune::BiCGSTABSolver<Vector> solver(*operator_, *amg_, tol_, max_iter_, verbosity_);
+        solver.apply(x, rhs, res);
+    } else {
+        flexible_->apply(x, rhs, res);
+    }
+
+    if (!res.converged) {
+        *output_ << "Fracture pressure solve did not converge" << std::endl;
+    }
+}
+
+} // namespace Opm
@@ -0,0 +1,124 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FRACTURE_PRESSURE_SOLVER_HPP_INCLUDED
+#define OPM_FRACTURE_PRESSURE_SOLVER_HPP_INCLUDED
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/paamg/amg.hh>
+#include <dune/istl/preconditioners.hh>
+
+#include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+// Linear solver for the fracture pressure system.  The system is solved many times
+// with the same sparsity pattern and new values, so the setup is split into a part
+// that only depends on the pattern, done by setMatrix(), and a part that depends on
+// the values, done by updateValues().  Available methods:
+//
+//   "direct": UMFPACK LU.  The symbolic analysis (fill-reducing ordering) is kept,
+//             and only the numeric factorization is redone for new values.
+//   "amg":    BiCGSTAB with algebraic multigrid.  The aggregates are kept, and only
+//             the Galerkin products of the coarse levels are redone for new values.
+//   other:    a FlexibleSolver with this linear solver ("umfpack", "ilu0", ...).
+//             Its preconditioner is updated for new values, and a direct solver
+//             is rebuilt.
+class FracturePressureSolver
+{
+public:
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+
+    FracturePressureSolver(const std::string& method, double tol, int max_iter, int verbosity);
+    ~FracturePressureSolver();
+
+    FracturePressureSolver(const FracturePressureSolver&) = delete;
+    FracturePressureSolver& operator=(const FracturePressureSolver&) = delete;
+
+    // full setup for 'A', which must be kept alive and compressed.  Must be called
+    // again if the sparsity pattern of 'A' changes.
+    void setMatrix(const Matrix& A);
+
+    // the values (but not the pattern) of the matrix given to setMatrix() changed
+    void updateValues();
+
+    // x = A^-1 b
+    void solve(Vector& x, const Vector& b);
+
+    const std::string& method() const
+    {
+        return method_;
+    }
+
+    // stream for warnings (std::cout by default)
+    void setOutputStream(std::ostream& os)
+    {
+        output_ = &os;
+    }
+
+private:
+    using Operator = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+    using Smoother = Dune::SeqSSOR<Matrix, Vector, Vector>;
+    using AMG = Dune::Amg::AMG<Operator, Vector, Smoother>;
+    using FlexibleSolverType = Dune::FlexibleSolver<Operator>;
+
+    void copyValues();
+    void factorNumeric();
+    void freeFactors();
+    void setupFlexibleSolver();
+
+    std::string method_;
+    double tol_;
+    int max_iter_;
+    int verbosity_;
+    std::ostream* output_ {&std::cout};
+    const Matrix* matrix_ {nullptr};
+    std::unique_ptr<Operator> operator_;
+
+    // "direct": the transposed (row-wise) matrix in the compressed column format of
+    // UMFPACK, and its symbolic and numeric factors
+    std::vector<int> col_start_;
+    std::vector<int> row_index_;
+    std::vector<double> values_;
+    void* symbolic_ {nullptr};
+    void* numeric_ {nullptr};
+
+    // "amg"
+    std::unique_ptr<AMG> amg_;
+
+    // other methods
+    PropertyTree flexible_prm_;
+    std::unique_ptr<FlexibleSolverType> flexible_;
+};
+
+} // namespace Opm
+
+#endif // OPM_FRACTURE_PRESSURE_SOLVER_HPP_INCLUDED
@@ -0,0 +1,101 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/FractureSettings.hpp>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <stdexcept>
+
+namespace Opm
+{
+InjectionControl
+makeInjectionControl(const PropertyTree& control)
+{
+    const auto type = control.get<std::string>("type");
+
+    if (type == "rate") {
+        return RateControl {control.get<double>("rate")};
+    } else if (type == "pressure") {
+        return PressureControl {control.get<double>("pressure")};
+    } else if (type == "perf_pressure") {
+        return PerfPressureControl {};
+    } else if (type == "rate_well") {
+        return RateWellControl {control.get<double>("rate"), control.get<double>("WI")};
+    }
+
+    OPM_THROW(std::runtime_error, "Unknown control of injection into Fracture: " + type);
+}
+
+FractureSolverSettings
+makeFractureSolverSettings(const PropertyTree& solver)
+{
+    FractureSolverSettings s;
+
+    s.method = solver.get<std::string>("method", s.method);
+    s.verbosity = solver.get<int>("verbosity", s.verbosity);
+
+    s.max_iter = solver.get<int>("max_iter", s.max_iter);
+    s.tolerance = solver.get<double>("tolerance", s.tolerance);
+    s.damping = solver.get<double>("damping", s.damping);
+    s.min_width = solver.get<double>("min_width", s.min_width);
+    s.max_width = solver.get<double>("max_width", s.max_width);
+    s.max_dwidth = solver.get<double>("max_dwidth", s.max_dwidth);
+    s.max_dp = solver.get<double>("max_dp", s.max_dp);
+    s.max_change = solver.get<double>("max_change", s.max_change);
+    s.anderson_depth = solver.get<int>("anderson_depth", s.anderson_depth);
+    s.warm_start = solver.get<bool>("warm_start", s.warm_start);
+    s.backtracking = solver.get<std::string>("line_search", "none") == "backtracking";
+    s.max_backtracks = solver.get<int>("max_backtracks", s.max_backtracks);
+    s.fused_assembly = solver.get<std::string>("assembly", "fused") == "fused";
+    s.active_set_contact = solver.get<std::string>("contact", "heuristic") == "active_set";
+    s.reuse_tol = solver.get<double>("reuse_tol", s.reuse_tol);
+    s.correction_tol = solver.get<double>("correction_tol", s.correction_tol);
+    s.adaptive_substeps = solver.get<std::string>("substeps", "none") == "adaptive";
+    s.min_substep = solver.get<double>("min_substep", s.min_substep);
+    s.substep_target_iter = solver.get<int>("substep_target_iter", s.substep_target_iter);
+
+    s.linsolver_tol = solver.get<double>("linsolver.tol", s.linsolver_tol);
+    s.linsolver_max_iter = solver.get<int>("linsolver.max_iter", s.linsolver_max_iter);
+    s.linsolver_verbosity = solver.get<int>("linsolver.verbosity", s.linsolver_verbosity);
+    s.schur_preconditioner = solver.get<std::string>("linsolver.preconditioner", "diag") == "schur";
+    s.dense_schur = solver.get<std::string>("linsolver.schur", "dense") == "dense";
+    s.schur_solver = solver.get<std::string>("linsolver.schur_solver", s.schur_solver);
+
+    s.ddm_storage = solver.get<std::string>("ddm.storage", s.ddm_storage);
+    s.single_precision = solver.get<std::string>("ddm.precision", "double") == "single";
+    s.refinement_tol = solver.get<double>("ddm.refinement.tol", s.refinement_tol);
+    s.refinement_max_iter = solver.get<int>("ddm.refinement.max_iter", s.refinement_max_iter);
+    s.ddm_threads = solver.get<int>("ddm.num_threads", s.ddm_threads);
+    s.incremental_assembly = solver.get<bool>("ddm.incremental", s.incremental_assembly);
+    s.hmatrix_tol = solver.get<double>("ddm.hmatrix.tol", s.hmatrix_tol);
+    s.hmatrix_leaf_size = solver.get<int>("ddm.hmatrix.leaf_size", s.hmatrix_leaf_size);
+    s.hmatrix_eta = solver.get<double>("ddm.hmatrix.eta", s.hmatrix_eta);
+
+    s.tree_field = solver.get<std::string>("ddm.field.method", "direct") == "tree";
+    s.field_order = solver.get<int>("ddm.field.order", s.field_order);
+    s.field_eta = solver.get<double>("ddm.field.eta", s.field_eta);
+    s.field_leaf_size = solver.get<int>("ddm.field.leaf_size", s.field_leaf_size);
+
+    return s;
+}
+
+} // namespace Opm
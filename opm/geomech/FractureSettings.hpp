@@ -0,0 +1,127 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FRACTURE_SETTINGS_HPP_INCLUDED
+#define OPM_FRACTURE_SETTINGS_HPP_INCLUDED
+
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <string>
+#include <variant>
+
+namespace Opm
+{
+// Injection control of a fracture ("control" in the fracture parameters).  The
+// alternatives are dispatched on with std::visit, so the kernels that depend on the
+// control are selected at compile time instead of by string comparisons.
+
+// given total rate, distributed evenly over the perforated fracture cells
+struct RateControl
+{
+    double rate {0.0};
+};
+
+// given injection pressure
+struct PressureControl
+{
+    double pressure {0.0};
+};
+
+// pressure of the perforation, taken from the reservoir well model
+struct PerfPressureControl
+{
+};
+
+// given rate [m3/day] of a well, coupled to the fracture by an extra well equation
+struct RateWellControl
+{
+    double rate {0.0};
+    double WI {0.0};
+};
+
+using InjectionControl
+    = std::variant<RateControl, PressureControl, PerfPressureControl, RateWellControl>;
+
+// throws if "type" is not one of "rate", "pressure", "perf_pressure" and "rate_well"
+InjectionControl makeInjectionControl(const PropertyTree& control);
+
+// Settings of the fracture solvers ("solver" in the fracture parameters), read
+// once so that the iterations need no property tree lookups.  Settings missing
+// from the parameters take the defaults of makeDefaultFractureParam().
+struct FractureSolverSettings
+{
+    std::string method {"if_propagate_trimesh"};
+    int verbosity {0};
+
+    // nonlinear iterations
+    int max_iter {100};
+    double tolerance {1e-6};
+    double damping {1.0};
+    double min_width {1e-3};
+    double max_width {0.5};
+    double max_dwidth {5e-3};
+    double max_dp {1e9};
+    double max_change {1e5};
+    int anderson_depth {5};
+    bool warm_start {false};
+    bool backtracking {false}; // "line_search" is "backtracking"
+    int max_backtracks {6};
+    bool fused_assembly {true}; // "assembly" is "fused"
+    bool active_set_contact {false}; // "contact" is "active_set"
+    // relative input change below which a solve is skipped or, for method "if",
+    // replaced by one correction step (0: always solve)
+    double reuse_tol {0.0};
+    double correction_tol {0.0};
+    // adaptive sub-stepping of method "if" ("substeps" is "adaptive"): smallest
+    // sub-step (fraction of the step) and iterations a sub-step should take
+    bool adaptive_substeps {false};
+    double min_substep {1.0 / 64};
+    int substep_target_iter {8};
+
+    // linear solver of the coupled system
+    double linsolver_tol {1e-10};
+    int linsolver_max_iter {1000};
+    int linsolver_verbosity {0};
+    bool schur_preconditioner {false}; // "linsolver.preconditioner" is "schur"
+    bool dense_schur {true}; // "linsolver.schur" is "dense"
+    std::string schur_solver {"umfpack"};
+
+    // mechanics (DDM) matrix
+    std::string ddm_storage {"dense"};
+    bool single_precision {false}; // "ddm.precision" is "single"
+    double refinement_tol {1e-12};
+    int refinement_max_iter {10};
+    int ddm_threads {1}; // "ddm.num_threads"
+    bool incremental_assembly {true}; // "ddm.incremental"
+    double hmatrix_tol {1e-6};
+    int hmatrix_leaf_size {32};
+    double hmatrix_eta {2.0};
+
+    // fracture induced fields
+    bool tree_field {false}; // "ddm.field.method" is "tree"
+    int field_order {6};
+    double field_eta {2.0};
+    int field_leaf_size {32};
+};
+
+FractureSolverSettings makeFractureSolverSettings(const PropertyTree& solver);
+
+} // namespace Opm
+
+#endif // OPM_FRACTURE_SETTINGS_HPP_INCLUDED
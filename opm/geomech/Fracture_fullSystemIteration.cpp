@@ -31,22 +31,30 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/common/TimingMacros.hpp>
 
+#include <opm/simulators/linalg/FlowLinearSolverParameters.hpp>
+#include <opm/simulators/linalg/setupPropertyTree.hpp>
+
 #include <opm/geomech/Fracture.hpp>
+#include <opm/geomech/MatrixFreeOperator.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace
 {
-static int DEBUG_COUNT = 0;
+static std::atomic<int> DEBUG_COUNT {0};
 std::string
 debug_filename(const std::string& prefix, const std::string& suffix = ".txt")
 {
@@ -64,11 +72,10 @@ using VectorHP = Dune::MultiTypeBlockVector<ResVector, ResVector>;
 
 using SMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>; // sparse matrix
 using FMatrix = Dune::DynamicMatrix<double>; // full matrix
+using SFMatrix = Dune::DynamicMatrix<float>; // full matrix, single precision
 
-using SystemMatrix = Dune::MultiTypeBlockMatrix<Dune::MultiTypeBlockVector<FMatrix, SMatrix>,
-                                                Dune::MultiTypeBlockVector<SMatrix, SMatrix>>;
-
-using Htrans = std::tuple<std::size_t, std::size_t, double, double>;
+using FlowConnections = Opm::Fracture::FlowConnections;
+using MatrixSlots = Opm::Fracture::MatrixSlots;
 
 // ============================ Debugging functions ============================
 // ----------------------------------------------------------------------------
@@ -184,7 +191,7 @@ makeIdentity(const std::size_t num,
 
 // ----------------------------------------------------------------------------
 std::unique_ptr<Opm::Fracture::Matrix>
-initCouplingMatrixSparsity(const std::vector<Htrans>& htrans,
+initCouplingMatrixSparsity(const FlowConnections& htrans,
                            const std::size_t num_cells,
                            const std::size_t num_wells)
 // ----------------------------------------------------------------------------
@@ -193,9 +200,9 @@ initCouplingMatrixSparsity(const std::vector<Htrans>& htrans,
     auto C = std::make_unique<Opm::Fracture::Matrix>(
         num_cells + num_wells, num_cells, 4, 0.4, Opm::Fracture::Matrix::implicit);
 
-    for (const auto& e : htrans) {
-        const std::size_t i = std::get<0>(e);
-        const std::size_t j = std::get<1>(e);
+    for (std::size_t k = 0; k < htrans.size(); ++k) {
+        const std::size_t i = htrans.i[k];
+        const std::size_t j = htrans.j[k];
 
         assert(i != j);
 
@@ -210,12 +217,56 @@ initCouplingMatrixSparsity(const std::vector<Htrans>& htrans,
     return C;
 }
 
+// ----------------------------------------------------------------------------
+inline std::pair<double, double>
+transmissibility_derivatives(const double h1, const double h2, const double t1, const double t2)
+// ----------------------------------------------------------------------------
+{
+    // derivatives of the cubic-law transmissibility of a connection with respect to
+    // the apertures of its two cells
+    const double q = (h1 * h1 * h1) * (h2 * h2 * h2) * (t1 * t2); // numerator
+    const double d1q = 3 * (h1 * h1) * (h2 * h2 * h2) * (t1 * t2);
+    const double d2q = 3 * (h1 * h1 * h1) * (h2 * h2) * (t1 * t2);
+
+    const double r = 12 * (h1 * h1 * t1 + h2 * h2 * t2); // denominator
+    const double d1r = 36 * (h1 * h1) * t1;
+    const double d2r = 36 * (h2 * h2) * t2;
+
+    const double dTdh1 = (r == 0) ? 0.0 : (d1q * r - q * d1r) / (r * r);
+    const double dTdh2 = (r == 0) ? 0.0 : (d2q * r - q * d2r) / (r * r);
+
+    return {dTdh1, dTdh2};
+}
+
+// ----------------------------------------------------------------------------
+void
+zero_closed_columns(double* const values,
+                    const MatrixSlots& slots,
+                    const FlowConnections& htrans,
+                    const std::vector<int>& closed_cells)
+// ----------------------------------------------------------------------------
+{
+    // all entries of the coupling matrix belong to a connection, so column i holds
+    // the (i,i) and (j,i) entries, column j the (j,j) and (i,j) entries
+    for (std::size_t k = 0; k < htrans.size(); ++k) {
+        if (closed_cells[htrans.i[k]]) {
+            values[slots.ii[k]] = 0;
+            values[slots.ji[k]] = 0;
+        }
+        if (closed_cells[htrans.j[k]]) {
+            values[slots.jj[k]] = 0;
+            values[slots.ij[k]] = 0;
+        }
+    }
+}
+
 // ----------------------------------------------------------------------------
 void
 updateCouplingMatrix(std::unique_ptr<Opm::Fracture::Matrix>& Cptr,
+                     MatrixSlots& slots,
                      const std::size_t num_cells,
                      const std::size_t num_wells,
-                     const std::vector<Htrans>& htrans,
+                     const FlowConnections& htrans,
                      const ResVector& pressure,
                      const ResVector& aperture,
                      const std::vector<int>& closed_cells,
@@ -226,6 +277,7 @@ updateCouplingMatrix(std::unique_ptr<Opm::Fracture::Matrix>& Cptr,
     // create C if not done already
     if (!Cptr) {
         Cptr = initCouplingMatrixSparsity(htrans, num_cells, num_wells);
+        slots = Opm::Fracture::matrixSlots(*Cptr, htrans);
     }
 
     // @@ NB: If the implementation of the pressure matrix changes (i.e.
@@ -233,8 +285,16 @@ updateCouplingMatrix(std::unique_ptr<Opm::Fracture::Matrix>& Cptr,
     //        the code below might need to be updated accordingly as well.
     auto& C = *Cptr;
     C = 0;
+    if (htrans.size() == 0) {
+        return;
+    }
 
-    for (const auto& [i, j, t1, t2] : htrans) {
+    double* const values = Opm::Fracture::matrixValues(C);
+    for (std::size_t k = 0; k < htrans.size(); ++k) {
+        const std::size_t i = htrans.i[k];
+        const std::size_t j = htrans.j[k];
+        const double t1 = htrans.t1[k];
+        const double t2 = htrans.t2[k];
         assert(i != j);
 
         const double h1 = aperture[i] + min_width;
@@ -242,37 +302,20 @@ updateCouplingMatrix(std::unique_ptr<Opm::Fracture::Matrix>& Cptr,
         const double p1 = pressure[i];
         const double p2 = pressure[j];
 
-        const double q = (h1 * h1 * h1) * (h2 * h2 * h2) * (t1 * t2); // numerator
-        const double d1q = 3 * (h1 * h1) * (h2 * h2 * h2) * (t1 * t2);
-        const double d2q = 3 * (h1 * h1 * h1) * (h2 * h2) * (t1 * t2);
-
-        const double r = 12 * (h1 * h1 * t1 + h2 * h2 * t2); // denominator
-        const double d1r = 36 * (h1 * h1) * t1;
-        const double d2r = 36 * (h2 * h2) * t2;
-
-        const double dTdh1 = (r == 0) ? 0.0 : (d1q * r - q * d1r) / (r * r);
-        const double dTdh2 = (r == 0) ? 0.0 : (d2q * r - q * d2r) / (r * r);
+        const auto [dTdh1, dTdh2] = transmissibility_derivatives(h1, h2, t1, t2);
 
         const double krull = 1; // 1e4; // @@ Not sure if this should be removed?
         // diagonal elements
-        C[i][i] += dTdh1 * (p1 - p2) * krull;
-        C[j][j] += dTdh2 * (p2 - p1) * krull;
+        values[slots.ii[k]] += dTdh1 * (p1 - p2) * krull;
+        values[slots.jj[k]] += dTdh2 * (p2 - p1) * krull;
 
         // off-diagonal elements
-        C[i][j] += dTdh2 * (p1 - p2) * krull;
-        C[j][i] += dTdh1 * (p2 - p1) * krull;
+        values[slots.ij[k]] += dTdh2 * (p1 - p2) * krull;
+        values[slots.ji[k]] += dTdh1 * (p2 - p1) * krull;
     }
 
     // zeroing out columns corresponding to closed cells
-    for (std::size_t col = 0; col != closed_cells.size(); ++col) {
-        if (closed_cells[col]) {
-            for (std::size_t row = 0; row != C.N(); ++row) {
-                if (C.exists(row, col)) {
-                    C[row][col] = 0;
-                }
-            }
-        }
-    }
+    zero_closed_columns(values, slots, htrans, closed_cells);
 }
 
 // ----------------------------------------------------------------------------
@@ -283,6 +326,15 @@ convergence_test(const VectorHP& res, const double tol_flow, const double tol_me
     return res[_0].infinity_norm() < tol_mech && res[_1].infinity_norm() < tol_flow;
 }
 
+// ----------------------------------------------------------------------------
+inline double
+scaled_residual_norm(const VectorHP& res, const double tol_flow, const double tol_mech)
+// ----------------------------------------------------------------------------
+{
+    // residual in units of the convergence tolerances (converged if below 1)
+    return std::max(res[_0].infinity_norm() / tol_mech, res[_1].infinity_norm() / tol_flow);
+}
+
 // ----------------------------------------------------------------------------
 template <typename Mat>
 ResVector
@@ -303,9 +355,9 @@ class TailoredPrecondDiag : public Dune::Preconditioner<VectorHP, VectorHP>
 // ----------------------------------------------------------------------------
 {
 public:
-    TailoredPrecondDiag(const SystemMatrix& S)
-        : A_diag_(diagvec(S[_0][_0]))
-        , M_diag_(diagvec(S[_1][_1]))
+    TailoredPrecondDiag(const ResVector& A_diag, const ResVector& M_diag)
+        : A_diag_(A_diag)
+        , M_diag_(M_diag)
     {
     }
 
@@ -375,34 +427,510 @@ modified_fracture_matrix(const FMatrix& A, const std::vector<int>& closed_cells)
     return result;
 }
 
+// ----------------------------------------------------------------------------
+ResVector
+masked_diagonal(const std::vector<double>& diag, const std::vector<int>& closed_cells)
+// ----------------------------------------------------------------------------
+{
+    // diagonal of the fracture matrix after closed rows have been made trivial
+    ResVector res(diag.size());
+
+    for (std::size_t i = 0; i != diag.size(); ++i) {
+        res[i] = closed_cells[i] ? 1.0 : diag[i];
+    }
+
+    return res;
+}
+
+// ----------------------------------------------------------------------------
+double
+masked_infinity_norm(const std::vector<double>& row_sums, const std::vector<int>& closed_cells)
+// ----------------------------------------------------------------------------
+{
+    // infinity norm of the fracture matrix after closed rows have been made trivial,
+    // given the sums of absolute values of each row of the matrix
+    double result = 0.0;
+
+    for (std::size_t row = 0; row != row_sums.size(); ++row) {
+        result = std::max(result, closed_cells[row] ? 1.0 : row_sums[row]);
+    }
+
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+inline void
+umvA(const FMatrix& A, const ResVector& x, ResVector& y)
+// ----------------------------------------------------------------------------
+{
+    A.umv(x, y);
+}
+
+// ----------------------------------------------------------------------------
+inline void
+umvA(const SFMatrix& A, const ResVector& x, ResVector& y)
+// ----------------------------------------------------------------------------
+{
+    // single precision entries, accumulated in double precision
+    for (std::size_t i = 0; i != A.N(); ++i) {
+        const auto& row = A[i];
+        double sum = 0.0;
+        for (std::size_t j = 0; j != A.M(); ++j) {
+            sum += row[j] * x[j][0];
+        }
+        y[i] += sum;
+    }
+}
+
+// ----------------------------------------------------------------------------
+inline void
+umvA(const ddm::MatrixFreeOperator& A, const ResVector& x, ResVector& y)
+// ----------------------------------------------------------------------------
+{
+    A.umv(&x[0][0], &y[0][0]);
+}
+
+// ----------------------------------------------------------------------------
+template <class AType>
+class CoupledSystemOperator : public Dune::LinearOperator<VectorHP, VectorHP>
+// ----------------------------------------------------------------------------
+{
+    // Applies the system [[A, I], [C, M]] without assembling it.  Rows of A
+    // belonging to closed cells act as identity rows (cf. `modified_fracture_matrix`).
+    // If C is null, the cross term is left out.
+public:
+    CoupledSystemOperator(const AType& A,
+                          const std::vector<int>& closed_cells,
+                          const SMatrix& I,
+                          const SMatrix* C,
+                          const SMatrix& M)
+        : A_(A)
+        , closed_cells_(closed_cells)
+        , I_(I)
+        , C_(C)
+        , M_(M)
+        , tmp_(closed_cells.size())
+    {
+    }
+
+    void apply(const VectorHP& x, VectorHP& y) const override
+    {
+        y = 0;
+        applyscaleadd(1.0, x, y);
+    }
+
+    void applyscaleadd(double alpha, const VectorHP& x, VectorHP& y) const override
+    {
+        tmp_ = 0;
+        umvA(A_, x[_0], tmp_);
+        for (std::size_t i = 0; i != closed_cells_.size(); ++i) {
+            y[_0][i] += alpha * (closed_cells_[i] ? x[_0][i] : tmp_[i]);
+        }
+        I_.usmv(alpha, x[_1], y[_0]);
+
+        if (C_) {
+            C_->usmv(alpha, x[_0], y[_1]);
+        }
+        M_.usmv(alpha, x[_1], y[_1]);
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+private:
+    const AType& A_;
+    const std::vector<int>& closed_cells_;
+    const SMatrix& I_;
+    const SMatrix* C_;
+    const SMatrix& M_;
+    mutable ResVector tmp_;
+};
+
+// ----------------------------------------------------------------------------
+class MaskedFractureInverse
+// ----------------------------------------------------------------------------
+{
+    // Applies the inverse of the fracture matrix A after the rows of the k closed
+    // cells have been replaced by identity rows (cf. `modified_fracture_matrix`),
+    // reusing the cached factorization of A.  The masked matrix is a rank-k update
+    // of A, and the Woodbury identity gives
+    //   x = A^-1 d - W K^-1 (x_c - d_c),   W = A^-1 E_c,   K = W_c,
+    // where E_c holds the unit vectors of the closed cells and W_c the rows of W
+    // belonging to them.  If many cells are closed, the masked matrix is factorized
+    // directly instead.
+public:
+    MaskedFractureInverse(const ddm::DenseLU& lu, const FMatrix& A, const std::vector<int>& closed_cells)
+        : lu_(lu)
+        , n_(A.N())
+    {
+        OPM_TIMEFUNCTION();
+
+        for (std::size_t i = 0; i != n_; ++i) {
+            if (closed_cells[i]) {
+                closed_.push_back(i);
+            }
+        }
+
+        const std::size_t k = closed_.size();
+        if (k == 0) {
+            return;
+        }
+
+        if (3 * k > n_) {
+            // the update costs O(k N^2), comparable to a new factorization
+            masked_lu_ = std::make_unique<ddm::DenseLU>(modified_fracture_matrix(A, closed_cells),
+                                                        lu.precision());
+            return;
+        }
+
+        W_.assign(n_ * k, 0.0); // column-major
+        for (std::size_t c = 0; c != k; ++c) {
+            W_[c * n_ + closed_[c]] = 1.0;
+        }
+        lu_.solve(W_.data(), k);
+
+        FMatrix K(k, k);
+        for (std::size_t c = 0; c != k; ++c) {
+            for (std::size_t r = 0; r != k; ++r) {
+                K[r][c] = W_[c * n_ + closed_[r]];
+            }
+        }
+        K_lu_ = std::make_unique<ddm::DenseLU>(K);
+    }
+
+    // X = Â^-1 X for 'nrhs' right-hand sides of size A.N(), stored column by column
+    void apply(double* X, const std::size_t nrhs) const
+    {
+        if (masked_lu_) {
+            masked_lu_->solve(X, nrhs);
+            return;
+        }
+
+        const std::size_t k = closed_.size();
+        if (k == 0) {
+            lu_.solve(X, nrhs);
+            return;
+        }
+
+        std::vector<double> T(k * nrhs); // x_c - d_c, for each right-hand side
+        for (std::size_t col = 0; col != nrhs; ++col) {
+            for (std::size_t r = 0; r != k; ++r) {
+                T[col * k + r] = -X[col * n_ + closed_[r]];
+            }
+        }
+
+        lu_.solve(X, nrhs);
+
+        for (std::size_t col = 0; col != nrhs; ++col) {
+            for (std::size_t r = 0; r != k; ++r) {
+                T[col * k + r] += X[col * n_ + closed_[r]];
+            }
+        }
+        K_lu_->solve(T.data(), nrhs);
+
+        for (std::size_t col = 0; col != nrhs; ++col) {
+            double* x = &X[col * n_];
+            for (std::size_t c = 0; c != k; ++c) {
+                const double* w = &W_[c * n_];
+                const double t = T[col * k + c];
+                for (std::size_t i = 0; i != n_; ++i) {
+                    x[i] -= w[i] * t;
+                }
+            }
+        }
+    }
+
+private:
+    const ddm::DenseLU& lu_;
+    std::size_t n_;
+    std::vector<std::size_t> closed_;
+    std::vector<double> W_;
+    std::unique_ptr<ddm::DenseLU> K_lu_;
+    std::unique_ptr<ddm::DenseLU> masked_lu_;
+};
+
+// ----------------------------------------------------------------------------
+class SchurPrecond : public Dune::Preconditioner<VectorHP, VectorHP>
+// ----------------------------------------------------------------------------
+{
+    // Block LDU approximation of the inverse of the system [[A, I], [C, M]]:
+    //   y = A^-1 d0,   v1 = S^-1 (d1 - C y),   v0 = A^-1 (d0 - I v1),
+    // where A^-1 uses the factorization of the fracture matrix (with closed rows
+    // masked) and S approximates the flow Schur complement M - C A^-1 I.
+    //
+    // With 'dense_schur', S is formed exactly from the factorization (N solves and
+    // a dense factorization of S, O(N^3) per setup), which makes the preconditioner
+    // an exact inverse.  Otherwise S = M - C diag(A)^-1 I, which keeps the sparsity
+    // of M and is solved with a FlexibleSolver (direct or AMG, as given by 'prm');
+    // this is much cheaper, but only effective when M dominates C A^-1 I.
+public:
+    SchurPrecond(const ddm::DenseLU& lu,
+                 const FMatrix& A,
+                 const std::vector<int>& closed_cells,
+                 const SMatrix& I,
+                 const SMatrix& C,
+                 const SMatrix& M,
+                 const bool dense_schur,
+                 const Opm::PropertyTree& prm)
+        : A_inv_(lu, A, closed_cells)
+        , I_(I)
+        , C_(C)
+        , y_(A.N())
+        , r_(M.N())
+    {
+        OPM_TIMEFUNCTION();
+
+        if (dense_schur) {
+            setupDenseSchur(closed_cells, M);
+            return;
+        }
+
+        // S = M - C D^-1 I, where I is the identity on open cells (and zero on
+        // closed ones), so only the columns of C belonging to open cells contribute
+        S_ = M;
+        for (auto row = C.begin(); row != C.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                const std::size_t j = col.index();
+                if (!closed_cells[j]) {
+                    assert(S_.exists(row.index(), j));
+                    S_[row.index()][j] -= (*col)[0][0] / A[j][j];
+                }
+            }
+        }
+
+        S_op_ = std::make_unique<SOperator>(S_);
+        S_solver_ = std::make_unique<SSolver>(*S_op_, prm, std::function<ResVector()>(), 0);
+    }
+
+    void apply(VectorHP& v, const VectorHP& d) override
+    {
+        // y = A^-1 d0
+        y_ = d[_0];
+        A_inv_.apply(&y_[0][0], 1);
+
+        // v1 = S^-1 (d1 - C y)
+        r_ = d[_1];
+        C_.mmv(y_, r_);
+        if (S_lu_) {
+            S_lu_->solve(&v[_1][0][0], &r_[0][0]);
+        } else {
+            v[_1] = 0;
+            Dune::InverseOperatorResult res;
+            S_solver_->apply(v[_1], r_, res); // NB: will modify 'r_'
+        }
+
+        // v0 = A^-1 (d0 - I v1)
+        v[_0] = d[_0];
+        I_.mmv(v[_1], v[_0]);
+        A_inv_.apply(&v[_0][0][0], 1);
+    }
+
+    void post([[maybe_unused]] VectorHP& v) override
+    {
+    }
+
+    void pre([[maybe_unused]] VectorHP& x, [[maybe_unused]] VectorHP& b) override
+    {
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+private:
+    using SOperator = Dune::MatrixAdapter<SMatrix, ResVector, ResVector>;
+    using SSolver = Dune::FlexibleSolver<SOperator>;
+
+    void setupDenseSchur(const std::vector<int>& closed_cells, const SMatrix& M)
+    {
+        const std::size_t nc = y_.size();
+        const std::size_t np = M.N();
+
+        // Z = A^-1 I, where column j of I is the unit vector e_j for open cells j,
+        // and zero otherwise
+        std::vector<double> Z(nc * np, 0.0); // column-major
+        for (std::size_t j = 0; j != nc; ++j) {
+            if (!closed_cells[j]) {
+                Z[j * nc + j] = 1.0;
+            }
+        }
+        A_inv_.apply(Z.data(), np);
+
+        // S = M - C Z
+        FMatrix S(np, np, 0.0);
+        for (auto row = M.begin(); row != M.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                S[row.index()][col.index()] = (*col)[0][0];
+            }
+        }
+
+        for (auto row = C_.begin(); row != C_.end(); ++row) {
+            auto& s_row = S[row.index()];
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                const std::size_t q = col.index();
+                const double c = (*col)[0][0];
+                for (std::size_t j = 0; j != np; ++j) {
+                    s_row[j] -= c * Z[j * nc + q];
+                }
+            }
+        }
+
+        S_lu_ = std::make_unique<ddm::DenseLU>(S);
+    }
+
+    MaskedFractureInverse A_inv_;
+    const SMatrix& I_;
+    const SMatrix& C_;
+    SMatrix S_;
+    std::unique_ptr<SOperator> S_op_;
+    std::unique_ptr<SSolver> S_solver_;
+    std::unique_ptr<ddm::DenseLU> S_lu_;
+    ResVector y_;
+    ResVector r_;
+};
+
 } // end anonymous namespace
 
 namespace Opm
 {
 // ----------------------------------------------------------------------------
 std::vector<int>
-Fracture::identify_closed(const FMatrix& A, const VectorHP& x, const ResVector& rhs, const int nwells)
+Fracture::identify_closed(const ResVector& Ah, const VectorHP& x, const ResVector& rhs)
 // ----------------------------------------------------------------------------
 {
     OPM_TIMEFUNCTION();
 
-    ResVector tmp(rhs);
-    const auto I = makeIdentity(A.N(), nwells);
-
-    // computing rhs - A x[0] - I x[1]
+    // computing rhs - A x[0] - I x[1] (I only picks the fracture cell pressures)
     const ResVector& h = x[_0];
     const ResVector& p = x[_1];
-    A.mmv(h, tmp);
-    I.mmv(p, tmp);
 
     std::vector<int> result;
-    for (std::size_t i = 0; i != A.N(); ++i) {
-        result.push_back(tmp[i] >= 0 && h[i] <= 0.0);
+    for (std::size_t i = 0; i != Ah.size(); ++i) {
+        const double tmp = rhs[i] - Ah[i] - p[i];
+        result.push_back(tmp >= 0 && h[i] <= 0.0);
+    }
+
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+std::vector<int>
+Fracture::identify_active_set(const ResVector& Ah,
+                              const VectorHP& x,
+                              const ResVector& rhs,
+                              const std::vector<double>& a_diag) const
+// ----------------------------------------------------------------------------
+{
+    OPM_TIMEFUNCTION();
+
+    // primal-dual active set rule for the complementarity conditions h >= 0,
+    // lambda >= 0, h * lambda = 0, with the contact traction lambda = rhs - A h - p.
+    // A cell is closed if lambda - c h > 0, where c = |A_ii| makes both terms
+    // comparable.  Unlike `identify_closed`, a cell with positive width closes
+    // as soon as its contact traction exceeds what the width can take up, and a
+    // closed cell reopens as soon as it is in tension.
+    const ResVector& h = x[_0];
+    const ResVector& p = x[_1];
+
+    std::vector<int> result(Ah.size());
+    for (std::size_t i = 0; i != Ah.size(); ++i) {
+        const double lambda = rhs[i] - Ah[i] - p[i];
+        result[i] = lambda > std::abs(a_diag[i]) * h[i];
     }
 
     return result;
 }
 
+// ----------------------------------------------------------------------------
+void
+Fracture::assembleFlowSystem(Matrix* const coupling)
+// ----------------------------------------------------------------------------
+{
+    OPM_TIMEFUNCTION();
+
+    // same operations, in the same order per matrix and vector entry, as
+    // assemblePressure(), addSource() and updateCouplingMatrix(), so that the
+    // results are identical
+    updateLeakoff();
+    initSource();
+
+    auto& matrix = *pressure_matrix_;
+    matrix = 0.0;
+    if (coupling) {
+        *coupling = 0;
+    }
+
+    double* const values = matrixValues(matrix);
+    double* const cvalues = coupling ? matrixValues(*coupling) : nullptr;
+    const auto& slots = pressure_slots_;
+    const auto& cslots = coupling_slots_;
+    for (std::size_t k = 0; k < htrans_.size(); ++k) {
+        const std::size_t i = htrans_.i[k];
+        const std::size_t j = htrans_.j[k];
+        const double t1 = htrans_.t1[k];
+        const double t2 = htrans_.t2[k];
+        const double h1 = fracture_width_[i] + min_width_;
+        const double h2 = fracture_width_[j] + min_width_;
+
+        // harmonic mean of surface flow
+        const double mobility = 0.5 * (reservoir_mobility_[i] + reservoir_mobility_[j]);
+        const double resistance = 12. / (h1 * h1 * h1 * t1) + 12. / (h2 * h2 * h2 * t2);
+
+        const double value = mobility / resistance;
+        values[slots.ij[k]] -= value;
+        values[slots.ji[k]] -= value;
+        values[slots.ii[k]] += value;
+        values[slots.jj[k]] += value;
+
+        // gravity (evaluated as in addSource())
+        const double source_value = (1 / resistance) * mobility;
+        const double dh = (fracture_dgh_[i] - fracture_dgh_[j]);
+        rhs_pressure_[i] -= source_value * dh;
+        rhs_pressure_[j] += source_value * dh;
+
+        if (cvalues) {
+            const double p1 = fracture_pressure_[i] - fracture_dgh_[i];
+            const double p2 = fracture_pressure_[j] - fracture_dgh_[j];
+            const auto [dTdh1, dTdh2] = transmissibility_derivatives(h1, h2, t1, t2);
+
+            cvalues[cslots.ii[k]] += dTdh1 * (p1 - p2);
+            cvalues[cslots.jj[k]] += dTdh2 * (p2 - p1);
+            cvalues[cslots.ij[k]] += dTdh2 * (p1 - p2);
+            cvalues[cslots.ji[k]] += dTdh1 * (p2 - p1);
+        }
+    }
+
+    assemblePressureLocal();
+    addLocalSources();
+}
+
+// ----------------------------------------------------------------------------
+void
+Fracture::resizeSystemWorkspace()
+// ----------------------------------------------------------------------------
+{
+    auto& ws = system_workspace_;
+    const std::size_t nc = fracture_width_.size();
+    const std::size_t np = fracture_pressure_.size();
+
+    if (ws.Ah.size() == nc && ws.x[_1].size() == np) {
+        return;
+    }
+
+    ws.identity = makeIdentity(nc, numWellEquations());
+
+    for (auto* v : {&ws.x, &ws.dx, &ws.rhs, &ws.res, &ws.ddx}) {
+        (*v)[_0].resize(nc);
+        (*v)[_1].resize(np);
+    }
+
+    ws.Ah.resize(nc);
+    ws.head.resize(np);
+}
+
 // ----------------------------------------------------------------------------
 bool
 Fracture::fullSystemIteration(const double tol)
@@ -412,32 +940,93 @@ Fracture::fullSystemIteration(const double tol)
 
     OPM_TIMEFUNCTION();
 
-    const double max_width = prm_.get<double>("solver.max_width");
+    const double max_width = settings_.max_width;
 
     // update pressure matrix with the current values of `fracture_width_` and
     // `fracture_pressure_`
-    assemblePressure(); // update pressure matrix
-    addSource(); // update right-hand side of pressure system;
+    const bool fused_assembly = settings_.fused_assembly;
+    if (fused_assembly) {
+        // pressure system and coupling matrix (except for closed cells) in one pass
+        if (!coupling_matrix_) {
+            coupling_matrix_ = initCouplingMatrixSparsity(
+                htrans_, pressure_matrix_->N() - numWellEquations(), numWellEquations());
+            coupling_slots_ = matrixSlots(*coupling_matrix_, htrans_);
+        }
+        assembleFlowSystem(coupling_matrix_.get());
+    } else {
+        assemblePressure(); // update pressure matrix
+        addSource(); // update right-hand side of pressure system;
+    }
+
+    // full-size objects are kept in a persistent workspace, see resizeSystemWorkspace()
+    resizeSystemWorkspace();
+    auto& ws = system_workspace_;
 
     //  initialize vector of unknown, and vector represnting direction in tangent space
-    VectorHP x {fracture_width_, fracture_pressure_};
-    dump_vector(x, "w", "p", true); // dump current state of fracture
+    VectorHP& x = ws.x;
+    x[_0] = fracture_width_;
+    x[_1] = fracture_pressure_;
+    if (debug_dumps_) {
+        dump_vector(x, "w", "p", true); // dump current state of fracture
+    }
 
-    VectorHP dx = x;
+    VectorHP& dx = ws.dx;
     dx = 0; // gradient of 'x' (which we aim to compute below)
 
     // set right hand side
-    VectorHP rhs {x}; // same size as system, content set below
+    VectorHP& rhs = ws.rhs; // same size as system, content set below
     normalFractureTraction(rhs[_0],
                            false); // right-hand side equals the normal fracture traction
     rhs[_1] = rhs_pressure_; // should have been updated in call to `assemblePressure` above
 
-    // make a version of the fracture matrix that has trivial equations for closed cells
-    const std::vector<int> closed_cells
-        = identify_closed(fractureMatrix(), x, rhs[_0], numWellEquations());
+    // diagonal and row sums of A, computed once per fracture matrix
+    if (!useMatrixFreeOperator() && ws.a_diag.size() != fractureMatrix().N()) {
+        const auto& A = fractureMatrix();
+        ws.a_diag.resize(A.N());
+        ws.a_row_sums.assign(A.N(), 0.0);
+        for (std::size_t i = 0; i != A.N(); ++i) {
+            ws.a_diag[i] = A[i][i];
+            for (std::size_t j = 0; j != A.M(); ++j) {
+                ws.a_row_sums[i] += std::abs(A[i][j]);
+            }
+        }
+    }
 
-    dump_vector(closed_cells, "closed_cells", true);
-    const auto A = modified_fracture_matrix(fractureMatrix(), closed_cells);
+    // identify closed cells, which get trivial equations in the fracture matrix
+    ResVector& Ah = ws.Ah;
+    Ah = 0;
+    fractureMatrixUmv(x[_0], Ah);
+
+    const bool active_set_contact = settings_.active_set_contact;
+    bool active_set_changed = false;
+    std::vector<int> closed_cells;
+    if (active_set_contact) {
+        // the active set of the previous iteration (or solve) is kept, and the
+        // iteration has only converged once it no longer changes
+        closed_cells = identify_active_set(
+            Ah, x, rhs[_0], useMatrixFreeOperator() ? fractureOperator().diagonal() : ws.a_diag);
+
+        std::size_t num_changed = closed_cells.size();
+        if (active_set_.size() == closed_cells.size()) {
+            num_changed = 0;
+            for (std::size_t i = 0; i != closed_cells.size(); ++i) {
+                num_changed += active_set_[i] != closed_cells[i];
+            }
+        }
+        active_set_changed = num_changed > 0;
+        if (settings_.verbosity > 0) {
+            outputStream() << "Active set: "
+                           << std::count(closed_cells.begin(), closed_cells.end(), 1) << " closed, "
+                           << num_changed << " changed" << std::endl;
+        }
+        active_set_ = closed_cells;
+    } else {
+        closed_cells = identify_closed(Ah, x, rhs[_0]);
+    }
+
+    if (debug_dumps_) {
+        dump_vector(closed_cells, "closed_cells", true);
+    }
 
     // also modify right hand side for closed cells
     for (std::size_t i = 0; i != closed_cells.size(); ++i) {
@@ -447,38 +1036,84 @@ Fracture::fullSystemIteration(const double tol)
     }
 
     // update the coupling matrix (possibly create it if not already initialized)
-    auto fracture_head = fracture_pressure_;
+    if (fused_assembly) {
+        if (htrans_.size() > 0) {
+            zero_closed_columns(matrixValues(*coupling_matrix_), coupling_slots_, htrans_, closed_cells);
+        }
+    } else {
+        ResVector& fracture_head = ws.head;
+        fracture_head = fracture_pressure_;
 
-    assert(fracture_dgh_.size() == fracture_pressure_.size());
-    for (int i = 0; i < fracture_dgh_.size(); ++i) {
-        fracture_head[i] = fracture_pressure_[i] - fracture_dgh_[i];
-    }
+        assert(fracture_dgh_.size() == fracture_pressure_.size());
+        for (int i = 0; i < fracture_dgh_.size(); ++i) {
+            fracture_head[i] = fracture_pressure_[i] - fracture_dgh_[i];
+        }
 
-    updateCouplingMatrix(coupling_matrix_,
-                         pressure_matrix_->N() - numWellEquations(), // num cells
-                         numWellEquations(), // num wells
-                         htrans_,
-                         fracture_head,
-                         fracture_width_,
-                         closed_cells,
-                         min_width_);
+        updateCouplingMatrix(coupling_matrix_,
+                             coupling_slots_,
+                             pressure_matrix_->N() - numWellEquations(), // num cells
+                             numWellEquations(), // num wells
+                             htrans_,
+                             fracture_head,
+                             fracture_width_,
+                             closed_cells,
+                             min_width_);
+    }
 
-    // setup the full system
+    // setup the full system.  The identity block couples the pressure into the
+    // mechanics equations of open cells only
     const auto& M = *pressure_matrix_;
     const auto& C = *coupling_matrix_;
-    const auto I = makeIdentity(A.N(), numWellEquations(), 1, closed_cells);
+    auto& I = ws.identity;
+    for (std::size_t i = 0; i != closed_cells.size(); ++i) {
+        I[i][i] = closed_cells[i] ? 0.0 : 1.0;
+    }
 
-    // system Jacobian (with cross term)  @@ should S be included as a member variable of
-    // Fracture?
-    SystemMatrix S {{A, I}, // mechanics system (since A is negative, we leave I positive here)
-                    {C, M}}; // flow system
+    if (debug_dumps_) {
+        dump_vector(rhs, "rhs_w", "rhs_p", true);
+    }
 
-    // system equations
-    SystemMatrix S0 = S;
-    S0[_1][_0] = 0; // the equations themselves have no cross term
+    // the closed rows of A are handled on the fly by the system operators, so the
+    // fracture matrix is never copied
+    std::unique_ptr<Dune::LinearOperator<VectorHP, VectorHP>> S_linop;
+    std::unique_ptr<Dune::Preconditioner<VectorHP, VectorHP>> precond;
+    std::unique_ptr<Dune::LinearOperator<VectorHP, VectorHP>> S_refine; // for mixed precision
+    double A_norm = 0.0;
+
+    if (useMatrixFreeOperator()) {
+        using HOperator = CoupledSystemOperator<ddm::MatrixFreeOperator>;
+        const auto& H = fractureOperator();
+
+        // rhs = rhs - S0 * x, where the equations themselves have no cross term
+        HOperator(H, closed_cells, I, nullptr, M).applyscaleadd(-1.0, x, rhs);
+
+        S_linop = std::make_unique<HOperator>(H, closed_cells, I, &C, M);
+        precond = std::make_unique<TailoredPrecondDiag>(masked_diagonal(H.diagonal(), closed_cells),
+                                                        diagvec(M));
+        A_norm = H.infinity_norm();
+    } else {
+        using DOperator = CoupledSystemOperator<FMatrix>;
+        const auto& A = fractureMatrix();
+
+        // rhs = rhs - S0 * x, where the equations themselves have no cross term
+        DOperator(A, closed_cells, I, nullptr, M).applyscaleadd(-1.0, x, rhs);
+
+        if (useSinglePrecision()) {
+            // the linear solver works on a single precision copy of the fracture
+            // matrix, while the residuals of the outer refinement use the double
+            // precision one
+            using SOperator = CoupledSystemOperator<SFMatrix>;
+            S_linop = std::make_unique<SOperator>(fractureMatrixSingle(), closed_cells, I, &C, M);
+            S_refine = std::make_unique<DOperator>(A, closed_cells, I, &C, M);
+        } else {
+            // system Jacobian (with cross term); since A is negative, I is left positive
+            S_linop = std::make_unique<DOperator>(A, closed_cells, I, &C, M);
+        }
 
-    dump_vector(rhs, "rhs_w", "rhs_p", true);
-    S0.mmv(x, rhs); // rhs = rhs - S0 * x;   (we are working in the tanget plane)
+        precond = std::make_unique<TailoredPrecondDiag>(masked_diagonal(ws.a_diag, closed_cells),
+                                                        diagvec(M));
+        A_norm = masked_infinity_norm(ws.a_row_sums, closed_cells);
+    }
 
     // check if system is already at a converged state (in which case we return
     // immediately)
@@ -486,73 +1121,211 @@ Fracture::fullSystemIteration(const double tol)
     // for convergence, we use 'tol' directly for the mechanics system (where
     // residuals are expected to scale with pressure), and 'tol * ||M||' for the
     // flow system (where residuals scale with M*p)
-    if (convergence_test(rhs,
-                         tol * M.infinity_norm(),
-                         std::max(tol, A.infinity_norm() * std::numeric_limits<double>::epsilon()))) {
+    const double tol_flow = tol * M.infinity_norm();
+    const double tol_mech = std::max(tol, A_norm * std::numeric_limits<double>::epsilon());
+    residual_history_.push_back(scaled_residual_norm(rhs, tol_flow, tol_mech));
+
+    if (!active_set_changed && convergence_test(rhs, tol_flow, tol_mech)) {
         return true;
     }
 
-    // solve system equations
-    const Dune::MatrixAdapter<SystemMatrix, VectorHP, VectorHP> S_linop(S);
+    const int nlin_verbosity = settings_.verbosity;
+
+    if (settings_.schur_preconditioner) {
+        if (useMatrixFreeOperator()) {
+            if (nlin_verbosity > 0) {
+                outputStream() << "Schur preconditioner requires dense DDM storage, using diagonal"
+                               << std::endl;
+            }
+        } else {
+            Opm::FlowLinearSolverParameters p;
+            p.linsolver_ = settings_.schur_solver;
+            const auto schur_prm = Opm::setupPropertyTree(p, true, true);
+            const bool dense_schur = settings_.dense_schur;
+
+            precond = std::make_unique<SchurPrecond>(fractureMatrixLU(),
+                                                     fractureMatrix(),
+                                                     closed_cells,
+                                                     I,
+                                                     C,
+                                                     M,
+                                                     dense_schur,
+                                                     schur_prm);
+        }
+    }
 
-    TailoredPrecondDiag precond(S); // cannot be 'const' due to BiCGstabsolver interface
+    // solve system equations
     Dune::InverseOperatorResult iores; // cannot be 'const' due to BiCGstabsolver interface
+    int num_lin_iter = 0;
 
-    const double linsolve_tol = prm_.get<double>("solver.linsolver.tol");
-    const int max_iter = prm_.get<double>("solver.linsolver.max_iter");
-    const int verbosity = prm_.get<double>("solver.linsolver.verbosity");
+    const double linsolve_tol = settings_.linsolver_tol;
+    const int max_iter = settings_.linsolver_max_iter;
+    const int verbosity = settings_.linsolver_verbosity;
 
-    auto psolver = Dune::BiCGSTABSolver<VectorHP>(S_linop,
-                                                  precond,
+    auto psolver = Dune::BiCGSTABSolver<VectorHP>(*S_linop,
+                                                  *precond,
                                                   linsolve_tol, // 1e-20, // desired rhs reduction factor
                                                   max_iter, // max number of iterations
                                                   verbosity); // verbose
-    {
+    if (S_refine == nullptr) {
         OPM_TIMEBLOCK(SolveCoupledSystem);
         psolver.apply(dx, rhs, iores); // NB: will modify 'rhs'
-    }
+        num_lin_iter = iores.iterations;
+    } else {
+        OPM_TIMEBLOCK(SolveCoupledSystem);
 
-    const int nlin_verbosity = prm_.get<double>("solver.verbosity");
-    if (nlin_verbosity > 1) {
-        std::cout << "x:  " << x[_0].infinity_norm() << " " << x[_1].infinity_norm() << '\n'
-                  << "dx: " << dx[_0].infinity_norm() << " " << dx[_1].infinity_norm() << std::endl;
+        // mixed precision iterative refinement: corrections are computed with the
+        // single precision system, and residuals with the double precision one
+        const int max_refine = settings_.refinement_max_iter;
+        const double rhs_norm = rhs.two_norm();
+
+        VectorHP& res = ws.res;
+        VectorHP& ddx = ws.ddx;
+        double rel_res = rhs_norm > 0.0 ? 1.0 : 0.0;
+        int num_refine = 0;
+
+        for (; rhs_norm > 0.0; ++num_refine) {
+            res = rhs;
+            S_refine->applyscaleadd(-1.0, dx, res);
+
+            rel_res = res.two_norm() / rhs_norm;
+            if (rel_res <= linsolve_tol || num_refine == max_refine) {
+                break;
+            }
+
+            ddx = 0;
+            psolver.apply(ddx, res, iores); // NB: will modify 'res'
+            num_lin_iter += iores.iterations;
+            dx += ddx;
+        }
+
+        if (rel_res > linsolve_tol || nlin_verbosity > 0) {
+            outputStream() << "Coupled system refinement: " << num_refine << " iterations, residual "
+                           << rel_res << (rel_res > linsolve_tol ? " (not converged)" : "") << std::endl;
+        }
+    }
+    if (nlin_verbosity > 0) {
+        outputStream() << "Coupled system: " << num_lin_iter << " linear iterations" << std::endl;
     }
 
-    // the following is a heuristic way to limit stepsize to stay within convergence
-    // radius
-    const double damping = prm_.get<double>("solver.damping");
-    const double step_fac = damping; // estimate_step_fac(x, dx) * damping;
     if (nlin_verbosity > 1) {
-        std::cout << "fac: " << step_fac << std::endl;
+        outputStream() << "x:  " << x[_0].infinity_norm() << " " << x[_1].infinity_norm() << '\n'
+                       << "dx: " << dx[_0].infinity_norm() << " " << dx[_1].infinity_norm() << std::endl;
     }
-    dx *= step_fac;
 
-    auto& dx0 = dx[_0];
-    const double max_dwidth = prm_.get<double>("solver.max_dwidth");
-    for (int i = 0; i != fracture_width_.size(); ++i) {
-        dx0[i][0] = std::max(-max_dwidth, std::min(max_dwidth, dx0[i][0]));
-    }
+    // the update is limited by a damping factor, followed by clamping of the changes
+    // in width and pressure, and of the width to non-negative values
+    const double max_dwidth = settings_.max_dwidth;
+    const double max_dp = settings_.max_dp;
+
+    const auto take_step = [&](const double fac, VectorHP& x_new) {
+        x_new = dx;
+        x_new *= fac;
 
-    auto& dx1 = dx[_1];
-    const double max_dp = prm_.get<double>("solver.max_dp");
-    for (int i = 0; i != fracture_pressure_.size(); ++i) {
-        dx1[i][0] = std::max(-max_dp, std::min(max_dp, dx1[i][0]));
+        for (auto& dw : x_new[_0]) {
+            dw[0] = std::clamp(dw[0], -max_dwidth, max_dwidth);
+        }
+        for (auto& dp : x_new[_1]) {
+            dp[0] = std::clamp(dp[0], -max_dp, max_dp);
+        }
+
+        x_new += x;
+        for (auto& w : x_new[_0]) {
+            w[0] = std::max(0.0, w[0]); // ensure non-negativity
+        }
+
+        // with the active set formulation, closed cells are exactly closed
+        // regardless of damping and clamping
+        if (active_set_contact) {
+            for (std::size_t i = 0; i != closed_cells.size(); ++i) {
+                if (closed_cells[i]) {
+                    x_new[_0][i] = 0.0;
+                }
+            }
+        }
+    };
+
+    // scaled residual of the (unlinearized) system at 'x_new', with the closed cells
+    // of this iteration.  Updates the pressure system for 'x_new'.
+    const auto trial_residual = [&](const VectorHP& x_new) {
+        fracture_width_ = x_new[_0];
+        fracture_pressure_ = x_new[_1];
+        if (fused_assembly) {
+            assembleFlowSystem(nullptr);
+        } else {
+            assemblePressure();
+            addSource();
+        }
+
+        VectorHP& res = ws.res;
+        normalFractureTraction(res[_0], false);
+        Ah = 0;
+        fractureMatrixUmv(x_new[_0], Ah);
+        for (std::size_t i = 0; i != closed_cells.size(); ++i) {
+            res[_0][i] = closed_cells[i] ? -x_new[_0][i] : res[_0][i] - Ah[i] - x_new[_1][i];
+        }
+
+        res[_1] = rhs_pressure_;
+        M.mmv(x_new[_1], res[_1]);
+
+        return scaled_residual_norm(res, tol_flow, tol_mech);
+    };
+
+    VectorHP& x_new = ws.ddx; // not needed by the linear solver any more
+
+    if (settings_.backtracking) {
+        // backtracking on the residual, starting from the damping factor of the last
+        // iteration, which grows again after steps that needed no backtracking
+        const double res0 = residual_history_.back();
+        const int max_backtracks = settings_.max_backtracks;
+        double fac = step_factor_;
+        bool accepted = false;
+
+        for (int k = 0;; ++k) {
+            take_step(fac, x_new);
+            const double res = trial_residual(x_new);
+            if (nlin_verbosity > 1) {
+                outputStream() << "fac: " << fac << " residual: " << res << " (" << res0 << ")"
+                               << std::endl;
+            }
+
+            accepted = res < (1.0 - 1e-4 * fac) * res0;
+            if (accepted || k == max_backtracks) {
+                break;
+            }
+
+            fac *= 0.5;
+        }
+
+        step_factor_ = (accepted && fac == step_factor_) ? std::min(1.0, 2.0 * fac) : fac;
+        if (!accepted && nlin_verbosity > 0) {
+            outputStream() << "Line search did not reduce the residual, using damping " << fac
+                           << std::endl;
+        }
+    } else {
+        // the following is a heuristic way to limit stepsize to stay within convergence
+        // radius
+        const double damping = settings_.damping;
+        const double step_fac = damping; // estimate_step_fac(x, dx) * damping;
+        if (nlin_verbosity > 1) {
+            outputStream() << "fac: " << step_fac << std::endl;
+        }
+        take_step(step_fac, x_new);
     }
 
-    dump_vector(dx, "dx_w", "dx_p", true);
-    x += dx;
+    dx = x_new;
+    dx -= x;
+    if (debug_dumps_) {
+        dump_vector(dx, "dx_w", "dx_p", true);
+    }
     if (nlin_verbosity > 1) {
-        std::cout << "after: dx: " << dx[_0].infinity_norm() << " " << dx[_1].infinity_norm()
-                  << std::endl;
+        outputStream() << "after: dx: " << dx[_0].infinity_norm() << " " << dx[_1].infinity_norm()
+                       << std::endl;
     }
 
     // copying modified variables back to member variables
-    fracture_width_ = x[_0];
-    for (int i = 0; i != fracture_width_.size(); ++i) {
-        fracture_width_[i][0] = std::max(0.0, fracture_width_[i][0]); // ensure non-negativity
-    }
-
-    fracture_pressure_ = x[_1];
+    fracture_width_ = x_new[_0];
+    fracture_pressure_ = x_new[_1];
 
     return false;
 }
@@ -10,6 +10,7 @@
 
 #include <opm/grid/UnstructuredGrid.h>
 
+#include <opm/geomech/AndersonAcceleration.hpp>
 #include <opm/geomech/RegularTrimesh.hpp>
 
 #include <algorithm>
@@ -17,6 +18,7 @@
 #include <cmath>
 #include <cstddef>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 namespace Opm
@@ -155,8 +157,8 @@ Fracture::updateReservoirProperties(const Simulator& simulator,
 
     //  get properties from well connections in case of filter cake
     if (schedule[reportStepIdx].wells.has(wellinfo_.name) == false) {
-        std::cerr << "Warning: Well " << wellinfo_.name << " not found in schedule step "
-                  << reportStepIdx << std::endl;
+        outputStream() << "Warning: Well " << wellinfo_.name << " not found in schedule step "
+                       << reportStepIdx << std::endl;
         return;
     }
 
@@ -173,16 +175,16 @@ Fracture::updateReservoirProperties(const Simulator& simulator,
 
     // const auto& connection = connections[wellinfo_.perf];// probably wrong
     if (connections.hasGlobalIndex(wellinfo_.global_index) == false) {
-        std::cerr << "Warning: Well connection with global index " << wellinfo_.global_index
-                  << " not found in schedule step " << reportStepIdx << std::endl;
+        outputStream() << "Warning: Well connection with global index " << wellinfo_.global_index
+                       << " not found in schedule step " << reportStepIdx << std::endl;
         return;
     }
 
     const auto& wellstates = simulator.problem().wellModel().wellState();
     const auto& well_index = wellstates.index(wellinfo_.name);
     if (!well_index.has_value()) {
-        std::cerr << "Warning: Well " << wellinfo_.name << " not found in well state at step "
-                  << reportStepIdx << std::endl;
+        outputStream() << "Warning: Well " << wellinfo_.name << " not found in well state at step "
+                       << reportStepIdx << std::endl;
         has_filtercake_ = false; // prevois state did not have this well
         return;
     }
@@ -202,14 +204,27 @@ Fracture::solve(const external::cvf::ref<external::cvf::BoundingBoxTree>& cell_s
 // ----------------------------------------------------------------------------
 {
     if (!active_) {
-        std::cout << "Fracture " << this->name() << " is not active, skipping solve." << std::endl;
+        outputStream() << "Fracture " << this->name() << " is not active, skipping solve." << std::endl;
         return;
     }
 
+    // inputs (almost) unchanged since the last full solve: keep or correct its solution
+    const FractureSolveKind kind = plannedSolve();
+    if (kind == FractureSolveKind::Skipped) {
+        outputStream() << "Fracture " << this->name() << " inputs unchanged, skipping solve."
+                       << std::endl;
+        ++solve_statistics_.skipped;
+        return;
+    }
+    const bool correction = (kind == FractureSolveKind::Correction);
+
+    // the recorded inputs are invalid until the solve succeeds
+    const int solved_grid_revision = std::exchange(solved_inputs_.grid_revision, -1);
+
     OPM_TIMEBLOCK(SolveFracture);
 
-    std::cout << "Solve Fracture Pressure" << std::endl;
-    const auto method = prm_.template get<std::string>("solver.method");
+    outputStream() << "Solve Fracture Pressure" << std::endl;
+    const auto& method = settings_.method;
 
     if (method == "nothing") {
     } else if (method == "simple") {
@@ -220,18 +235,41 @@ Fracture::solve(const external::cvf::ref<external::cvf::BoundingBoxTree>& cell_s
     } else if (method == "only_width") {
         this->solveFractureWidth();
     } else if (method == "iterative") {
-        const double tol = prm_.template get<double>("solver.max_change");
-        const int max_it = prm_.template get<int>("max_iter");
+        // split iteration: width from pressure, then pressure from width, accelerated
+        // over the stacked (width, pressure) vector.  Changes are measured in units of
+        // 1 cm width and 1 bar pressure.
+        constexpr double width_scale = 1e-2;
+        constexpr double pressure_scale = 1e5;
+        const double tol = settings_.max_change;
+        const int max_it = settings_.max_iter;
+        const int nlin_verbosity = settings_.verbosity;
+        const double min_width = settings_.min_width;
+        const double max_width = settings_.max_width;
+
+        initFractureStates(); // ensure initial fracture_width and fracture_pressure
+                              // set to something reasonable
+
+        AndersonAcceleration anderson(settings_.anderson_depth);
+        std::vector<double> x, gx, x_next;
+
+        const auto pack = [&](std::vector<double>& z) {
+            z.resize(fracture_width_.size() + fracture_pressure_.size());
+            std::size_t k = 0;
+            for (const auto& w : fracture_width_) {
+                z[k++] = w[0] / width_scale;
+            }
+            for (const auto& p : fracture_pressure_) {
+                z[k++] = p[0] / pressure_scale;
+            }
+        };
 
+        residual_history_.clear();
         int it = 0;
-        bool changed = true;
-        while (changed && (it < max_it)) {
-            initFractureStates(); // ensure initial fracture_width and fracture_pressure
-                                  // set to something reasonable
-
-            auto fracture_width = fracture_width_;
-            auto fracture_pressure = fracture_pressure_;
+        bool converged = false;
+        while (!converged && (it < max_it)) {
+            pack(x);
 
+            this->updateFractureRHS(); // width right-hand side from current pressure
             this->solveFractureWidth();
 
             // grow fracture
@@ -239,49 +277,119 @@ Fracture::solve(const external::cvf::ref<external::cvf::BoundingBoxTree>& cell_s
 
             it += 1;
 
+            pack(gx);
+            if (gx.size() != x.size()) {
+                // the pressure system got its final size, nothing to compare with
+                anderson.reset();
+                continue;
+            }
+
             double max_change = 0;
-            for (int i = 0; fracture_width_.size(); ++i) {
-                const double diff_width = fracture_width_[i] - fracture_width[i];
-                const double diff_press = fracture_pressure_[i] - fracture_pressure[i];
+            for (std::size_t i = 0; i < x.size(); ++i) {
+                max_change = std::max(max_change, std::abs(gx[i] - x[i]));
+            }
+            residual_history_.push_back(max_change);
+            if (nlin_verbosity > 1) {
+                outputStream() << "Iteration: " << it << " max change: " << max_change << std::endl;
+            }
 
-                max_change = std::max({max_change, diff_width / 1e-2, diff_press / 1e5});
+            converged = (max_change < tol);
+            if (converged || anderson.depth() == 0) {
+                continue; // keep the state computed by the last sweep
             }
 
-            changed = (max_change < tol);
+            anderson.update(x, gx, x_next);
+            const std::size_t nw = fracture_width_.size();
+            for (std::size_t i = 0; i < nw; ++i) {
+                fracture_width_[i] = std::clamp(x_next[i] * width_scale, min_width, max_width);
+            }
+            for (std::size_t i = 0; i < fracture_pressure_.size(); ++i) {
+                fracture_pressure_[i] = x_next[nw + i] * pressure_scale;
+            }
+        }
+
+        if (nlin_verbosity > 0) {
+            outputStream() << "Fracture split iteration "
+                           << (converged ? "converged" : "did not converge") << " after " << it
+                           << " iterations" << std::endl;
         }
 
+        setWarmStartState(converged);
+
         // ----------------------------------------------------------------------------
     } else if (method == "if") {
         // ----------------------------------------------------------------------------
         // iterate full nonlinear system until convergence
-        std::cout << "Solve Fracture Pressure using Iterative Fracture" << std::endl;
-        const double min_width = prm_.get<double>("solver.min_width");
-        for (auto& width : fracture_width_) {
-            width[0] = std::max(width[0], min_width); // Ensure not completely closed
-        }
+        outputStream() << "Solve Fracture Pressure using Iterative Fracture" << std::endl;
+        const int nlin_verbosity = settings_.verbosity;
 
-        // start by assuming pressure equal to confining stress (will also set
-        // fracture_pressure_ to its correct size
-        normalFractureTraction(fracture_pressure_);
+        // sub-steps start from the solution of the last full solve on this grid
+        const bool substeps = settings_.adaptive_substeps && !correction && canContinueSolve()
+            && solved_grid_revision == grid_revision_;
 
-        if (numWellEquations() > 0) {
-            // @@ it is implicitly assumed for now that there is just one
-            // well equation.  We initializze it with an existing value.
-            fracture_pressure_[fracture_pressure_.size() - 1] = fracture_pressure_[0];
+        if (correction || substeps || canWarmStart()) {
+            // continue from the solution of the previous solve on the same grid
+            if (nlin_verbosity > 0) {
+                outputStream() << "Warm start from previous fracture solution" << std::endl;
+            }
+        } else {
+            const double min_width = settings_.min_width;
+            for (auto& width : fracture_width_) {
+                width[0] = std::max(width[0], min_width); // Ensure not completely closed
+            }
+
+            // start by assuming pressure equal to confining stress (will also set
+            // fracture_pressure_ to its correct size
+            normalFractureTraction(fracture_pressure_);
+
+            if (numWellEquations() > 0) {
+                // @@ it is implicitly assumed for now that there is just one
+                // well equation.  We initializze it with an existing value.
+                fracture_pressure_[fracture_pressure_.size() - 1] = fracture_pressure_[0];
+            }
         }
 
-        const double tol = prm_.template get<int>("solver.tolerance"); // 1e-5; // @@
-        const int max_iter = prm_.template get<int>("solver.max_iter");
-        const int nlin_verbosity = prm_.get<double>("solver.verbosity");
+        const double tol = settings_.tolerance; // 1e-5; // @@
+        // a correction is a single iteration
+        const int max_iter = correction ? 0 : settings_.max_iter;
 
-        int iter = 0;
         // solve flow-mechanical system
-        while (!fullSystemIteration(tol) && (iter++ < max_iter)) {
-            if (nlin_verbosity > 1) {
-                std::cout << "Iteration: " << iter << std::endl;
+        const auto iterate = [&](int& iter) {
+            step_factor_ = settings_.damping;
+            residual_history_.clear();
+
+            iter = 0;
+            bool converged = false;
+            while (!(converged = fullSystemIteration(tol)) && (iter++ < max_iter)) {
+                if (nlin_verbosity > 1) {
+                    outputStream() << "Iteration: " << iter << std::endl;
+                }
             }
+            return converged;
+        };
+
+        int iter = 0;
+        const bool converged = substeps ? solveInSubsteps(iterate) : iterate(iter);
+
+        if (nlin_verbosity > 0 && correction) {
+            outputStream() << "Fracture system corrected by one iteration" << std::endl;
+        } else if (nlin_verbosity > 0 && !substeps) {
+            outputStream() << "Fracture system " << (converged ? "converged" : "did not converge")
+                           << " after " << iter << " iterations" << std::endl;
+        }
+
+        if (nlin_verbosity > 1) {
+            outputStream() << "Residual history:";
+            for (const double res : residual_history_) {
+                outputStream() << " " << res;
+            }
+            outputStream() << std::endl;
         }
 
+        // only a converged state is a good initial guess for the next solve.  A
+        // correction starts from one, and the input change is small.
+        setWarmStartState(converged || correction);
+
         // @@ debug
         const std::vector<double> K1_not_nan = Fracture::stressIntensityK1();
         std::vector<double> K1;
@@ -291,54 +399,62 @@ Fracture::solve(const external::cvf::ref<external::cvf::BoundingBoxTree>& cell_s
             }
         }
 
-        std::cout << "K1: " << *std::min_element(K1.begin(), K1.end()) << ", "
-                  << *std::max_element(K1.begin(), K1.end()) << '\n';
+        outputStream() << "K1: " << *std::min_element(K1.begin(), K1.end()) << ", "
+                       << *std::max_element(K1.begin(), K1.end()) << '\n';
 
-        std::cout << "Pressure: "
-                  << *std::min_element(fracture_pressure_.begin(), fracture_pressure_.end()) << ", "
-                  << *std::max_element(fracture_pressure_.begin(), fracture_pressure_.end()) << '\n';
+        outputStream() << "Pressure: "
+                       << *std::min_element(fracture_pressure_.begin(), fracture_pressure_.end()) << ", "
+                       << *std::max_element(fracture_pressure_.begin(), fracture_pressure_.end())
+                       << '\n';
 
-        std::cout << "Normal traction: ";
+        outputStream() << "Normal traction: ";
         Dune::BlockVector<Dune::FieldVector<double, 1>> krull(fracture_width_);
         normalFractureTraction(krull, false);
 
-        std::cout << *std::min_element(krull.begin(), krull.end()) << ", "
-                  << *std::max_element(krull.begin(), krull.end()) << '\n';
+        outputStream() << *std::min_element(krull.begin(), krull.end()) << ", "
+                       << *std::max_element(krull.begin(), krull.end()) << '\n';
 
-        std::cout << "Aperture: ";
-        std::cout << *std::min_element(fracture_width_.begin(), fracture_width_.end()) << ", "
-                  << *std::max_element(fracture_width_.begin(), fracture_width_.end()) << std::endl;
+        outputStream() << "Aperture: ";
+        outputStream() << *std::min_element(fracture_width_.begin(), fracture_width_.end()) << ", "
+                       << *std::max_element(fracture_width_.begin(), fracture_width_.end()) << std::endl;
 
         // ----------------------------------------------------------------------------
     } else if (method == "if_propagate_trimesh") {
         // ----------------------------------------------------------------------------
 
-        if (true) {
+        // with warm start, the previous solution (if converged) is transferred to each
+        // trial grid below, otherwise every trial grid starts from the initial state
+        const bool warm_start = settings_.warm_start && has_warm_start_state_
+            && fracture_width_.size() == grid_mesh_map_.size()
+            && fracture_pressure_.size() == grid_mesh_map_.size() + numWellEquations();
+
+        if (!warm_start) {
             fracture_width_ = 1e-3; // Ensure not completely closed
             fracture_pressure_ = perf_pressure_;
-        }
 
-        // start by assuming pressure equal to confining stress (will also set
-        // fracture_pressure_ to its correct size
-        normalFractureTraction(fracture_pressure_);
+            // start by assuming pressure equal to confining stress (will also set
+            // fracture_pressure_ to its correct size
+            normalFractureTraction(fracture_pressure_);
 
-        // It is implicitly assumed for now that there is just one well equation.
-        // We initialize with an existing value. @@
-        if (numWellEquations() > 0) {
-            fracture_pressure_[fracture_pressure_.size() - 1] = fracture_pressure_[0];
+            // It is implicitly assumed for now that there is just one well equation.
+            // We initialize with an existing value. @@
+            if (numWellEquations() > 0) {
+                fracture_pressure_[fracture_pressure_.size() - 1] = fracture_pressure_[0];
+            }
         }
 
-        // save original grid and filtercake, to allow us to map it onto evolved grids
+        // save original grid, filtercake and solution, to allow us to map them onto
+        // evolved grids
         const auto filtercake_thickness_0 = filtercake_thikness_; // copy
         const auto grid_mesh_map_0 = grid_mesh_map_;
+        const auto fracture_width_0 = fracture_width_;
+        const auto fracture_pressure_0 = fracture_pressure_;
 
         // local function taking a trimesh, updates the Fracture object with it and
         // runs a simulation.  Its return value should be a vector of doubles:
 
         auto score_function
             = [&](const RegularTrimesh& trimesh, const int level) -> std::vector<double> {
-            const int max_iter = prm_.get<int>("solver.max_iter");
-            const double tol = prm_.get<double>("solver.tolerance"); //,1e-8);
             *trimesh_ = trimesh;
 
             // save well sources before grid change
@@ -383,21 +499,23 @@ Fracture::solve(const external::cvf::ref<external::cvf::BoundingBoxTree>& cell_s
 
             // solve flow-mechanical system
             bool point_wise = true;
-            bool remap_solution = false;
-            if (remap_solution) {
-                for (std::size_t i = 0; i < fracture_pressure_.size(); ++i) {
-                    assert(std::abs(fracture_pressure_[i][0]) < 1e10);
-                    assert(std::abs(fracture_width_[i][0]) < 0.6);
+            if (warm_start) {
+                // transfer the previous solution from the original grid
+                fracture_width_ = fracture_width_0;
+                redistribute_values(fracture_width_, grid_mesh_map_0, fsmap, level, point_wise);
+
+                // the well equations are not part of the grid, and are kept as they are
+                const std::size_t nc0 = grid_mesh_map_0.size();
+                fracture_pressure_.resize(nc0);
+                for (std::size_t i = 0; i != nc0; ++i) {
+                    fracture_pressure_[i] = fracture_pressure_0[i];
                 }
+                redistribute_values(fracture_pressure_, grid_mesh_map_0, fsmap, level, point_wise);
 
-                auto old_fracture_width_ = fracture_width_;
-                redistribute_values(fracture_width_, grid_mesh_map_, fsmap, level, point_wise);
-
-                redistribute_values(fracture_pressure_, grid_mesh_map_, fsmap, level, point_wise);
-                // solve flow-mechanical system
-                for (std::size_t i = 0; i < fracture_pressure_.size(); ++i) {
-                    assert(std::abs(fracture_pressure_[i][0]) < 1e10);
-                    assert(std::abs(fracture_width_[i][0]) < 0.6);
+                const std::size_t nc = fracture_pressure_.size();
+                fracture_pressure_.resize(nc + numWellEquations());
+                for (int i = 0; i != numWellEquations(); ++i) {
+                    fracture_pressure_[nc + i] = fracture_pressure_0[nc0 + i];
                 }
             } else {
                 initFractureWidth();
@@ -428,8 +546,13 @@ Fracture::solve(const external::cvf::ref<external::cvf::BoundingBoxTree>& cell_s
         const int target_cellcount = prm_.get<int>("solver.target_cellcount");
         const int cellcount_threshold = prm_.get<int>("solver.cellcount_threshold");
 
-        const auto& [mesh, cur_level] = expand_to_criterion(
-            *trimesh_, score_function, threshold, fixed_cells, target_cellcount, cellcount_threshold);
+        const auto& [mesh, cur_level] = expand_to_criterion(*trimesh_,
+                                                            score_function,
+                                                            threshold,
+                                                            fixed_cells,
+                                                            target_cellcount,
+                                                            cellcount_threshold,
+                                                            outputStream());
 
         // make current level become the reference (finest) level
         // note that the well_source_cellref_ is already set from the last call to the
@@ -438,6 +561,10 @@ Fracture::solve(const external::cvf::ref<external::cvf::BoundingBoxTree>& cell_s
             cell = RegularTrimesh::fine_to_coarse(cell, cur_level);
         }
 
+        // the score function does not solve the flow-mechanical system, so the state
+        // left by the search is not a converged solution to start the next solve from
+        setWarmStartState(false);
+
         // ----------------------------------------------------------------------------
     } else if (method == "if_propagate") {
         // ----------------------------------------------------------------------------
@@ -457,8 +584,8 @@ Fracture::solve(const external::cvf::ref<external::cvf::BoundingBoxTree>& cell_s
             fracture_pressure_[fracture_pressure_.size() - 1] = fracture_pressure_[0];
         }
 
-        const int max_iter = prm_.template get<int>("solver.max_iter");
-        const double tol = prm_.template get<double>("solver.tolerance"); //,1e-8);
+        const int max_iter = settings_.max_iter;
+        const double tol = settings_.tolerance; //,1e-8);
 
         const double efac = prm_.template get<double>("solver.efac"); // 2; // @@ heuristic
         const double rfac = prm_.template get<double>("solver.rfac"); // 2; // @@ heuristic
@@ -529,25 +656,36 @@ Fracture::solve(const external::cvf::ref<external::cvf::BoundingBoxTree>& cell_s
             // debug stuff
 
             // grid has changed its geometry, so we have to recompute discretizations
-            updateCellNormals();
+            updateGeometry();
             updateReservoirCells(cell_search_tree);
             updateReservoirProperties<TypeTag, Simulator>(simulator, true, false);
             initPressureMatrix();
 
-            fracture_matrix_ = nullptr;
+            invalidateFractureMatrix();
 
             const auto& pts = grid_stretcher_->nodecoords();
             const auto bix = grid_stretcher_->boundaryNodeIndices();
         }
 
         if (count >= max_expand_iter) {
-            std::cout << "Fracture expansion did not converge within the maximum number "
+            outputStream() << "Fracture expansion did not converge within the maximum number "
                          "of iterations"
-                      << std::endl;
+                           << std::endl;
         }
     } else {
         OPM_THROW(std::runtime_error, "Unknowns solution method");
     }
+
+    if (correction) {
+        // later changes are still measured from the last full solve
+        solved_inputs_.grid_revision = solved_grid_revision;
+        ++solve_statistics_.correction;
+    } else {
+        if (canContinueSolve()) {
+            recordSolveInputs();
+        }
+        ++solve_statistics_.full;
+    }
 }
 
 } // namespace Opm
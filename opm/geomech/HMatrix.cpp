@@ -0,0 +1,374 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/HMatrix.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace
+{
+double
+dot(const double* a, const double* b, const std::size_t n, const std::size_t stride)
+{
+    double result = 0.0;
+    for (std::size_t i = 0; i != n; ++i) {
+        result += a[i * stride] * b[i * stride];
+    }
+
+    return result;
+}
+
+} // Anonymous namespace
+
+namespace ddm
+{
+HMatrix::HMatrix(const std::vector<Point>& row_points,
+                 const std::vector<Point>& col_points,
+                 const Kernel& kernel,
+                 const Params& params)
+    : num_rows_(row_points.size())
+    , num_cols_(col_points.size())
+    , params_(params)
+{
+    // points are clusters of zero extent
+    buildClusterTree(row_points, row_points, params_.leaf_size, row_perm_, row_tree_);
+    buildClusterTree(col_points, col_points, params_.leaf_size, col_perm_, col_tree_);
+
+    if (num_rows_ == 0 || num_cols_ == 0) {
+        return;
+    }
+
+    buildBlockTree(0, 0);
+
+    // compute the entries of all blocks.  Blocks are independent, so this can
+    // be done in parallel.
+    const int num_blocks = static_cast<int>(blocks_.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(params_.num_threads, 1))
+#endif
+    for (int b = 0; b < num_blocks; ++b) {
+        auto& block = blocks_[b];
+        if (!block.low_rank || !computeLowRankBlock(block, kernel)) {
+            computeDenseBlock(block, kernel);
+        }
+    }
+
+    diagonal_.resize(std::min(num_rows_, num_cols_));
+    for (std::size_t i = 0; i != diagonal_.size(); ++i) {
+        diagonal_[i] = kernel(i, i);
+    }
+
+    // estimate of the row sum norm, using |U V^T|_ij <= sum_k |U_ik| |V_jk|
+    std::vector<double> rowsum(num_rows_, 0.0);
+    for (const auto& block : blocks_) {
+        const auto& rc = row_tree_[block.row_cluster];
+        const auto& cc = col_tree_[block.col_cluster];
+        const std::size_t m = rc.end - rc.begin;
+        const std::size_t n = cc.end - cc.begin;
+
+        if (block.low_rank) {
+            std::vector<double> vsum(block.rank, 0.0);
+            for (std::size_t j = 0; j != n; ++j) {
+                for (int k = 0; k != block.rank; ++k) {
+                    vsum[k] += std::abs(block.V[j * block.rank + k]);
+                }
+            }
+
+            for (std::size_t i = 0; i != m; ++i) {
+                for (int k = 0; k != block.rank; ++k) {
+                    rowsum[row_perm_[rc.begin + i]] += std::abs(block.U[i * block.rank + k]) * vsum[k];
+                }
+            }
+        } else {
+            for (std::size_t i = 0; i != m; ++i) {
+                for (std::size_t j = 0; j != n; ++j) {
+                    rowsum[row_perm_[rc.begin + i]] += std::abs(block.U[i * n + j]);
+                }
+            }
+        }
+    }
+
+    inf_norm_ = *std::max_element(rowsum.begin(), rowsum.end());
+}
+
+void
+HMatrix::buildBlockTree(const int rc, const int cc)
+{
+    const auto& r = row_tree_[rc];
+    const auto& c = col_tree_[cc];
+
+    const double dist = boxDistance(r.lo, r.hi, c.lo, c.hi);
+    const double diam = std::min(boxDiameter(r.lo, r.hi), boxDiameter(c.lo, c.hi));
+
+    const bool r_leaf = r.child[0] < 0;
+    const bool c_leaf = c.child[0] < 0;
+
+    if (dist > 0.0 && diam <= params_.eta * dist) {
+        Block block;
+        block.row_cluster = rc;
+        block.col_cluster = cc;
+        block.low_rank = true;
+        blocks_.push_back(std::move(block));
+    } else if (r_leaf && c_leaf) {
+        Block block;
+        block.row_cluster = rc;
+        block.col_cluster = cc;
+        blocks_.push_back(std::move(block));
+    } else if (r_leaf) {
+        buildBlockTree(rc, c.child[0]);
+        buildBlockTree(rc, c.child[1]);
+    } else if (c_leaf) {
+        buildBlockTree(r.child[0], cc);
+        buildBlockTree(r.child[1], cc);
+    } else {
+        const auto rch = r.child;
+        const auto cch = c.child;
+        for (const int ri : rch) {
+            for (const int ci : cch) {
+                buildBlockTree(ri, ci);
+            }
+        }
+    }
+}
+
+void
+HMatrix::computeDenseBlock(Block& block, const Kernel& kernel) const
+{
+    const auto& rc = row_tree_[block.row_cluster];
+    const auto& cc = col_tree_[block.col_cluster];
+    const std::size_t m = rc.end - rc.begin;
+    const std::size_t n = cc.end - cc.begin;
+
+    block.low_rank = false;
+    block.rank = 0;
+    block.V.clear();
+    block.U.resize(m * n);
+
+    for (std::size_t i = 0; i != m; ++i) {
+        for (std::size_t j = 0; j != n; ++j) {
+            block.U[i * n + j] = kernel(row_perm_[rc.begin + i], col_perm_[cc.begin + j]);
+        }
+    }
+}
+
+bool
+HMatrix::computeLowRankBlock(Block& block, const Kernel& kernel) const
+{
+    // Adaptive cross approximation with partial pivoting.  Returns 'false' if
+    // the block turned out not to be compressible, in which case it should be
+    // stored as a dense block.
+    const auto& rc = row_tree_[block.row_cluster];
+    const auto& cc = col_tree_[block.col_cluster];
+    const std::size_t m = rc.end - rc.begin;
+    const std::size_t n = cc.end - cc.begin;
+
+    // beyond this rank, a low-rank block uses more memory than a dense one
+    const int max_rank = static_cast<int>((m * n) / (m + n));
+
+    std::vector<std::vector<double>> us; // columns of U (length m)
+    std::vector<std::vector<double>> vs; // columns of V (length n)
+    std::vector<bool> used_row(m, false);
+
+    double frob2 = 0.0; // squared Frobenius norm of current approximation
+    std::size_t pivot_row = 0;
+    int num_zero_rows = 0;
+
+    while (static_cast<int>(us.size()) < max_rank) {
+        used_row[pivot_row] = true;
+
+        // residual of the pivot row
+        std::vector<double> v(n);
+        for (std::size_t j = 0; j != n; ++j) {
+            v[j] = kernel(row_perm_[rc.begin + pivot_row], col_perm_[cc.begin + j]);
+        }
+
+        for (std::size_t k = 0; k != us.size(); ++k) {
+            const double uk = us[k][pivot_row];
+            for (std::size_t j = 0; j != n; ++j) {
+                v[j] -= uk * vs[k][j];
+            }
+        }
+
+        const auto jmax = std::max_element(
+            v.begin(), v.end(), [](double a, double b) { return std::abs(a) < std::abs(b); });
+        const std::size_t pivot_col = std::distance(v.begin(), jmax);
+        const double pivot = v[pivot_col];
+
+        if (std::abs(pivot) <= std::numeric_limits<double>::min()) {
+            // row already well approximated; try another one
+            const auto next = std::find(used_row.begin(), used_row.end(), false);
+            if (next == used_row.end() || ++num_zero_rows > 3) {
+                break;
+            }
+
+            pivot_row = std::distance(used_row.begin(), next);
+            continue;
+        }
+
+        for (auto& vj : v) {
+            vj /= pivot;
+        }
+
+        // residual of the pivot column
+        std::vector<double> u(m);
+        for (std::size_t i = 0; i != m; ++i) {
+            u[i] = kernel(row_perm_[rc.begin + i], col_perm_[cc.begin + pivot_col]);
+        }
+
+        for (std::size_t k = 0; k != us.size(); ++k) {
+            const double vk = vs[k][pivot_col];
+            for (std::size_t i = 0; i != m; ++i) {
+                u[i] -= vk * us[k][i];
+            }
+        }
+
+        // update the norm of the approximation
+        const double unorm2 = dot(u.data(), u.data(), m, 1);
+        const double vnorm2 = dot(v.data(), v.data(), n, 1);
+        for (std::size_t k = 0; k != us.size(); ++k) {
+            frob2 += 2.0 * dot(u.data(), us[k].data(), m, 1) * dot(v.data(), vs[k].data(), n, 1);
+        }
+        frob2 += unorm2 * vnorm2;
+
+        us.push_back(std::move(u));
+        vs.push_back(std::move(v));
+
+        if (std::sqrt(unorm2 * vnorm2) <= params_.tol * std::sqrt(std::abs(frob2))) {
+            break; // converged
+        }
+
+        // next pivot row: largest entry of the last column among unused rows
+        const auto& ulast = us.back();
+        double best = -1.0;
+        for (std::size_t i = 0; i != m; ++i) {
+            if (!used_row[i] && std::abs(ulast[i]) > best) {
+                best = std::abs(ulast[i]);
+                pivot_row = i;
+            }
+        }
+
+        if (best < 0.0) {
+            break; // all rows used, approximation is exact
+        }
+    }
+
+    const int rank = static_cast<int>(us.size());
+    if (rank >= max_rank) {
+        return false;
+    }
+
+    block.low_rank = true;
+    block.rank = rank;
+    block.U.resize(m * rank);
+    block.V.resize(n * rank);
+
+    for (int k = 0; k != rank; ++k) {
+        for (std::size_t i = 0; i != m; ++i) {
+            block.U[i * rank + k] = us[k][i];
+        }
+
+        for (std::size_t j = 0; j != n; ++j) {
+            block.V[j * rank + k] = vs[k][j];
+        }
+    }
+
+    return true;
+}
+
+void
+HMatrix::umv(const double* x, double* y, const double alpha) const
+{
+    std::vector<double> xloc;
+    std::vector<double> tmp;
+
+    for (const auto& block : blocks_) {
+        const auto& rc = row_tree_[block.row_cluster];
+        const auto& cc = col_tree_[block.col_cluster];
+        const std::size_t m = rc.end - rc.begin;
+        const std::size_t n = cc.end - cc.begin;
+
+        xloc.resize(n);
+        for (std::size_t j = 0; j != n; ++j) {
+            xloc[j] = x[col_perm_[cc.begin + j]];
+        }
+
+        if (block.low_rank) {
+            const int rank = block.rank;
+
+            // tmp = V^T x
+            tmp.assign(rank, 0.0);
+            for (std::size_t j = 0; j != n; ++j) {
+                for (int k = 0; k != rank; ++k) {
+                    tmp[k] += block.V[j * rank + k] * xloc[j];
+                }
+            }
+
+            // y += alpha * U tmp
+            for (std::size_t i = 0; i != m; ++i) {
+                double val = 0.0;
+                for (int k = 0; k != rank; ++k) {
+                    val += block.U[i * rank + k] * tmp[k];
+                }
+
+                y[row_perm_[rc.begin + i]] += alpha * val;
+            }
+        } else {
+            for (std::size_t i = 0; i != m; ++i) {
+                double val = 0.0;
+                for (std::size_t j = 0; j != n; ++j) {
+                    val += block.U[i * n + j] * xloc[j];
+                }
+
+                y[row_perm_[rc.begin + i]] += alpha * val;
+            }
+        }
+    }
+}
+
+std::size_t
+HMatrix::numStoredValues() const
+{
+    std::size_t result = 0;
+    for (const auto& block : blocks_) {
+        result += block.U.size() + block.V.size();
+    }
+
+    return result;
+}
+
+int
+HMatrix::maxRank() const
+{
+    int result = 0;
+    for (const auto& block : blocks_) {
+        result = std::max(result, block.rank);
+    }
+
+    return result;
+}
+
+} // namespace ddm
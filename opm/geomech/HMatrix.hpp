@@ -0,0 +1,117 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_HMATRIX_HPP_INCLUDED
+#define OPM_HMATRIX_HPP_INCLUDED
+
+#include <opm/geomech/ClusterTree.hpp>
+#include <opm/geomech/MatrixFreeOperator.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace ddm
+{
+// Hierarchical matrix approximation of a dense (boundary element type) operator.
+//
+// Rows and columns are associated with points in space (e.g. triangle
+// centroids).  Both point sets are organised in a cluster tree by recursive
+// bisection, and pairs of clusters that are well separated are approximated by
+// low-rank blocks computed with adaptive cross approximation (ACA with partial
+// pivoting).  Only O(N log N) kernel evaluations and storage are needed, as
+// opposed to O(N^2) for the full matrix.
+class HMatrix : public MatrixFreeOperator
+{
+public:
+    using Point = std::array<double, 3>;
+    using Kernel = std::function<double(std::size_t row, std::size_t col)>;
+
+    struct Params
+    {
+        double tol {1e-6}; // relative accuracy of each low-rank block
+        std::size_t leaf_size {32}; // clusters with fewer points are not subdivided
+        double eta {2.0}; // admissibility: min(diam) <= eta * dist
+        int num_threads {1}; // threads used to compute blocks (requires OpenMP)
+    };
+
+    HMatrix(const std::vector<Point>& row_points,
+            const std::vector<Point>& col_points,
+            const Kernel& kernel,
+            const Params& params);
+
+    std::size_t N() const override
+    {
+        return num_rows_;
+    }
+
+    std::size_t M() const override
+    {
+        return num_cols_;
+    }
+
+    void umv(const double* x, double* y, double alpha = 1.0) const override;
+
+    const std::vector<double>& diagonal() const override
+    {
+        return diagonal_;
+    }
+
+    // upper bound of the row sum norm (exact for the dense blocks)
+    double infinity_norm() const override
+    {
+        return inf_norm_;
+    }
+
+    std::size_t numStoredValues() const override;
+    int maxRank() const;
+
+private:
+    struct Block
+    {
+        int row_cluster {};
+        int col_cluster {};
+        bool low_rank {false};
+        int rank {0};
+        std::vector<double> U; // row-major (num_rows x rank), or full block if dense
+        std::vector<double> V; // row-major (num_cols x rank)
+    };
+
+    void buildBlockTree(int rc, int cc);
+    void computeDenseBlock(Block& block, const Kernel& kernel) const;
+    bool computeLowRankBlock(Block& block, const Kernel& kernel) const;
+
+    std::size_t num_rows_ {0};
+    std::size_t num_cols_ {0};
+    Params params_;
+
+    std::vector<std::size_t> row_perm_;
+    std::vector<std::size_t> col_perm_;
+    std::vector<Cluster> row_tree_;
+    std::vector<Cluster> col_tree_;
+    std::vector<Block> blocks_;
+
+    std::vector<double> diagonal_;
+    double inf_norm_ {0.0};
+};
+
+} // namespace ddm
+
+#endif // OPM_HMATRIX_HPP_INCLUDED
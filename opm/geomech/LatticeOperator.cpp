@@ -0,0 +1,309 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/geomech/LatticeOperator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using Complex = std::complex<double>;
+
+std::size_t
+nextPowerOfTwo(const std::size_t n)
+{
+    std::size_t result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+// in-place radix-2 FFT of 'n' values spaced 'stride' apart.  'twiddle' holds
+// exp(-2 pi i k / n) for k < n/2.  The inverse transform is not scaled.
+void
+fft(Complex* a,
+    const std::size_t n,
+    const std::size_t stride,
+    const std::vector<Complex>& twiddle,
+    const bool inverse)
+{
+    // bit-reversal permutation
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j) {
+            std::swap(a[i * stride], a[j * stride]);
+        }
+    }
+
+    for (std::size_t len = 2; len <= n; len <<= 1) {
+        const std::size_t half = len / 2;
+        const std::size_t step = n / len;
+        for (std::size_t i = 0; i < n; i += len) {
+            for (std::size_t k = 0; k != half; ++k) {
+                const Complex w = inverse ? std::conj(twiddle[k * step]) : twiddle[k * step];
+                const Complex u = a[(i + k) * stride];
+                const Complex v = a[(i + k + half) * stride] * w;
+                a[(i + k) * stride] = u + v;
+                a[(i + k + half) * stride] = u - v;
+            }
+        }
+    }
+}
+
+std::vector<Complex>
+makeTwiddle(const std::size_t n)
+{
+    std::vector<Complex> result(n / 2);
+    for (std::size_t k = 0; k != result.size(); ++k) {
+        result[k] = std::polar(1.0, -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n));
+    }
+
+    return result;
+}
+
+// 2D transform of a row-major (n0 x n1) array
+void
+fft2d(std::vector<Complex>& a, const std::array<std::size_t, 2>& n, const bool inverse)
+{
+    const auto tw0 = makeTwiddle(n[0]);
+    const auto tw1 = makeTwiddle(n[1]);
+
+    for (std::size_t i = 0; i != n[0]; ++i) {
+        fft(&a[i * n[1]], n[1], 1, tw1, inverse);
+    }
+
+    for (std::size_t j = 0; j != n[1]; ++j) {
+        fft(&a[j], n[0], n[1], tw0, inverse);
+    }
+}
+
+} // Anonymous namespace
+
+namespace ddm
+{
+LatticeOperator::LatticeOperator(const std::vector<LatticeIndex>& cells,
+                                 const LatticeKernel& lattice_kernel,
+                                 const Kernel& kernel,
+                                 [[maybe_unused]] const int num_threads)
+    : num_cells_(cells.size())
+{
+    // split cells in lattice and irregular cells, and find the lattice extent
+    std::array<int, 2> lo {std::numeric_limits<int>::max(), std::numeric_limits<int>::max()};
+    std::array<int, 2> hi {std::numeric_limits<int>::min(), std::numeric_limits<int>::min()};
+
+    for (std::size_t c = 0; c != num_cells_; ++c) {
+        if (cells[c][2] == 0 || cells[c][2] == 1) {
+            lattice_cells_.push_back(c);
+            for (int d = 0; d != 2; ++d) {
+                lo[d] = std::min(lo[d], cells[c][d]);
+                hi[d] = std::max(hi[d], cells[c][d]);
+            }
+        } else {
+            irregular_cells_.push_back(c);
+        }
+    }
+
+    const std::size_t nl = lattice_cells_.size();
+    const std::size_t ni = irregular_cells_.size();
+
+    diagonal_.assign(num_cells_, 0.0);
+    std::vector<double> rowsum(num_cells_, 0.0);
+
+    if (nl > 0) {
+        // the FFT grid must hold all offsets -(n-1)..(n-1) without wrap-around
+        const std::array<int, 2> extent {hi[0] - lo[0] + 1, hi[1] - lo[1] + 1};
+        for (int d = 0; d != 2; ++d) {
+            fft_size_[d] = nextPowerOfTwo(2 * extent[d] - 1);
+        }
+
+        for (const auto c : lattice_cells_) {
+            lattice_pos_.push_back((cells[c][0] - lo[0]) * fft_size_[1] + (cells[c][1] - lo[1]));
+            lattice_orientation_.push_back(cells[c][2]);
+        }
+
+        // evaluate the kernel once for each offset and orientation pair
+        const std::size_t fft_len = fft_size_[0] * fft_size_[1];
+        std::array<double, 4> kernel_abssum {0.0, 0.0, 0.0, 0.0};
+
+        for (int o = 0; o != 4; ++o) {
+            auto& khat = kernel_hat_[o];
+            khat.assign(fft_len, 0.0);
+
+            const int di_min = -(extent[0] - 1);
+            const int num_di = 2 * extent[0] - 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(num_threads, 1))
+#endif
+            for (int k = 0; k < num_di; ++k) {
+                const int di = di_min + k;
+                const std::size_t row = (di + fft_size_[0]) % fft_size_[0];
+                for (int dj = -(extent[1] - 1); dj <= extent[1] - 1; ++dj) {
+                    const std::size_t col = (dj + fft_size_[1]) % fft_size_[1];
+                    khat[row * fft_size_[1] + col] = lattice_kernel(o / 2, o % 2, di, dj);
+                }
+            }
+
+            for (const auto& v : khat) {
+                kernel_abssum[o] += std::abs(v.real());
+            }
+
+            fft2d(khat, fft_size_, false);
+        }
+
+        for (std::size_t l = 0; l != nl; ++l) {
+            const int o = lattice_orientation_[l];
+            diagonal_[lattice_cells_[l]] = lattice_kernel(o, o, 0, 0);
+            rowsum[lattice_cells_[l]] = kernel_abssum[2 * o] + kernel_abssum[2 * o + 1];
+        }
+    }
+
+    // explicit couplings of irregular cells
+    irregular_rows_.resize(ni * num_cells_);
+    irregular_cols_.resize(nl * ni);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(num_threads, 1))
+#endif
+    for (int r = 0; r < static_cast<int>(ni); ++r) {
+        for (std::size_t c = 0; c != num_cells_; ++c) {
+            irregular_rows_[r * num_cells_ + c] = kernel(irregular_cells_[r], c);
+        }
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(num_threads, 1))
+#endif
+    for (int l = 0; l < static_cast<int>(nl); ++l) {
+        for (std::size_t r = 0; r != ni; ++r) {
+            irregular_cols_[l * ni + r] = kernel(lattice_cells_[l], irregular_cells_[r]);
+        }
+    }
+
+    for (std::size_t r = 0; r != ni; ++r) {
+        const auto row = irregular_rows_.begin() + r * num_cells_;
+        diagonal_[irregular_cells_[r]] = row[irregular_cells_[r]];
+        for (std::size_t c = 0; c != num_cells_; ++c) {
+            rowsum[irregular_cells_[r]] += std::abs(row[c]);
+        }
+    }
+
+    for (std::size_t l = 0; l != nl; ++l) {
+        for (std::size_t r = 0; r != ni; ++r) {
+            rowsum[lattice_cells_[l]] += std::abs(irregular_cols_[l * ni + r]);
+        }
+    }
+
+    inf_norm_ = rowsum.empty() ? 0.0 : *std::max_element(rowsum.begin(), rowsum.end());
+}
+
+void
+LatticeOperator::umv(const double* x, double* y, const double alpha) const
+{
+    const std::size_t nl = lattice_cells_.size();
+    const std::size_t ni = irregular_cells_.size();
+
+    if (nl > 0) {
+        // Both orientations are transformed at once, by packing them in the real
+        // and imaginary part of a single (complex) grid
+        const std::size_t n0 = fft_size_[0];
+        const std::size_t n1 = fft_size_[1];
+
+        std::vector<Complex> z(n0 * n1, 0.0);
+        for (std::size_t l = 0; l != nl; ++l) {
+            const double xl = x[lattice_cells_[l]];
+            z[lattice_pos_[l]] += lattice_orientation_[l] == 0 ? Complex(xl, 0.0) : Complex(0.0, xl);
+        }
+
+        fft2d(z, fft_size_, false);
+
+        // unpack the transforms of the two (real) grids, multiply with the
+        // kernels and pack the two (real) results again
+        std::vector<Complex> w(n0 * n1);
+        for (std::size_t i = 0; i != n0; ++i) {
+            for (std::size_t j = 0; j != n1; ++j) {
+                const std::size_t k = i * n1 + j;
+                const Complex zk = z[k];
+                const Complex zm = std::conj(z[((n0 - i) % n0) * n1 + (n1 - j) % n1]);
+
+                const Complex x0 = 0.5 * (zk + zm);
+                const Complex x1 = Complex(0.0, -0.5) * (zk - zm);
+
+                const Complex y0 = kernel_hat_[0][k] * x0 + kernel_hat_[1][k] * x1;
+                const Complex y1 = kernel_hat_[2][k] * x0 + kernel_hat_[3][k] * x1;
+
+                w[k] = y0 + Complex(0.0, 1.0) * y1;
+            }
+        }
+
+        fft2d(w, fft_size_, true);
+
+        const double scale = alpha / static_cast<double>(n0 * n1);
+        for (std::size_t l = 0; l != nl; ++l) {
+            const Complex wl = w[lattice_pos_[l]];
+            y[lattice_cells_[l]] += scale * (lattice_orientation_[l] == 0 ? wl.real() : wl.imag());
+        }
+    }
+
+    for (std::size_t l = 0; l != nl; ++l) {
+        double val = 0.0;
+        for (std::size_t r = 0; r != ni; ++r) {
+            val += irregular_cols_[l * ni + r] * x[irregular_cells_[r]];
+        }
+
+        y[lattice_cells_[l]] += alpha * val;
+    }
+
+    for (std::size_t r = 0; r != ni; ++r) {
+        double val = 0.0;
+        for (std::size_t c = 0; c != num_cells_; ++c) {
+            val += irregular_rows_[r * num_cells_ + c] * x[c];
+        }
+
+        y[irregular_cells_[r]] += alpha * val;
+    }
+}
+
+std::size_t
+LatticeOperator::numStoredValues() const
+{
+    std::size_t result = irregular_rows_.size() + irregular_cols_.size();
+    for (const auto& khat : kernel_hat_) {
+        result += 2 * khat.size();
+    }
+
+    return result;
+}
+
+} // namespace ddm
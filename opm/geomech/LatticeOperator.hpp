@@ -0,0 +1,112 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_LATTICE_OPERATOR_HPP_INCLUDED
+#define OPM_LATTICE_OPERATOR_HPP_INCLUDED
+
+#include <opm/geomech/MatrixFreeOperator.hpp>
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace ddm
+{
+// Operator on a grid whose cells are (mostly) the triangles of a uniform
+// lattice, such as the fine-scale cells of a RegularTrimesh.
+//
+// Between two lattice cells the kernel only depends on their offset in the
+// lattice and on the orientation (0 or 1) of each triangle.  It is therefore
+// evaluated once per distinct offset, and the product is computed as a
+// discrete convolution using FFTs: O(N) storage and O(N log N) work.  Cells
+// that are not on the lattice (coarse cells of a multiresolution grid,
+// smoothing triangles along the boundary) are coupled through explicitly
+// stored rows and columns.
+class LatticeOperator : public MatrixFreeOperator
+{
+public:
+    using LatticeIndex = std::array<int, 3>; // (i, j, orientation), orientation -1 if off the lattice
+    using Kernel = std::function<double(std::size_t row, std::size_t col)>;
+    // influence on a cell of orientation 'o_obs' from one of orientation 'o_src'
+    // with lattice position (i_obs - i_src, j_obs - j_src) = (di, dj)
+    using LatticeKernel = std::function<double(int o_obs, int o_src, int di, int dj)>;
+
+    LatticeOperator(const std::vector<LatticeIndex>& cells,
+                    const LatticeKernel& lattice_kernel,
+                    const Kernel& kernel,
+                    const int num_threads = 1);
+
+    std::size_t N() const override
+    {
+        return num_cells_;
+    }
+
+    std::size_t M() const override
+    {
+        return num_cells_;
+    }
+
+    void umv(const double* x, double* y, double alpha = 1.0) const override;
+
+    const std::vector<double>& diagonal() const override
+    {
+        return diagonal_;
+    }
+
+    double infinity_norm() const override
+    {
+        return inf_norm_;
+    }
+
+    std::size_t numStoredValues() const override;
+
+    std::size_t numLatticeCells() const
+    {
+        return lattice_cells_.size();
+    }
+
+    std::size_t numIrregularCells() const
+    {
+        return irregular_cells_.size();
+    }
+
+private:
+    std::size_t num_cells_ {0};
+    std::array<std::size_t, 2> fft_size_ {1, 1}; // powers of two
+
+    std::vector<std::size_t> lattice_cells_; // cell index of each lattice cell
+    std::vector<std::size_t> lattice_pos_; // its position in the (row-major) FFT grid
+    std::vector<int> lattice_orientation_;
+    std::vector<std::size_t> irregular_cells_;
+
+    // transformed kernels, indexed by 2 * o_obs + o_src
+    std::array<std::vector<std::complex<double>>, 4> kernel_hat_;
+
+    std::vector<double> irregular_rows_; // row-major (irregular x all cells)
+    std::vector<double> irregular_cols_; // row-major (lattice x irregular cells)
+
+    std::vector<double> diagonal_;
+    double inf_norm_ {0.0};
+};
+
+} // namespace ddm
+
+#endif // OPM_LATTICE_OPERATOR_HPP_INCLUDED
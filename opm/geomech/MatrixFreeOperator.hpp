@@ -0,0 +1,127 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MATRIX_FREE_OPERATOR_HPP_INCLUDED
+#define OPM_MATRIX_FREE_OPERATOR_HPP_INCLUDED
+
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solvercategory.hh>
+
+#include <cstddef>
+#include <vector>
+
+namespace ddm
+{
+// Common interface of the compressed representations of the (dense) DDM
+// fracture matrix, which are only accessed through matrix-vector products.
+class MatrixFreeOperator
+{
+public:
+    virtual ~MatrixFreeOperator() = default;
+
+    virtual std::size_t N() const = 0;
+    virtual std::size_t M() const = 0;
+
+    // y += alpha * A x.  'x' and 'y' must have at least M() and N() entries.
+    virtual void umv(const double* x, double* y, double alpha = 1.0) const = 0;
+
+    virtual const std::vector<double>& diagonal() const = 0;
+
+    // upper bound of the row sum norm
+    virtual double infinity_norm() const = 0;
+
+    virtual std::size_t numStoredValues() const = 0; // number of doubles stored
+
+    double compressionRatio() const // stored values divided by N() * M()
+    {
+        const double full = static_cast<double>(N()) * static_cast<double>(M());
+        return full > 0.0 ? numStoredValues() / full : 1.0;
+    }
+};
+
+// Dune operator applying a MatrixFreeOperator to a (scalar) BlockVector
+template <class X>
+class MatrixFreeLinearOperator : public Dune::LinearOperator<X, X>
+{
+public:
+    using field_type = typename X::field_type;
+
+    explicit MatrixFreeLinearOperator(const MatrixFreeOperator& A)
+        : A_(A)
+    {
+    }
+
+    void apply(const X& x, X& y) const override
+    {
+        y = 0;
+        A_.umv(&x[0][0], &y[0][0]);
+    }
+
+    void applyscaleadd(field_type alpha, const X& x, X& y) const override
+    {
+        A_.umv(&x[0][0], &y[0][0], alpha);
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+private:
+    const MatrixFreeOperator& A_;
+};
+
+// Point Jacobi preconditioner based on the (exact) diagonal of a MatrixFreeOperator
+template <class X>
+class MatrixFreeJacobi : public Dune::Preconditioner<X, X>
+{
+public:
+    explicit MatrixFreeJacobi(const MatrixFreeOperator& A)
+        : diag_(A.diagonal())
+    {
+    }
+
+    void pre([[maybe_unused]] X& x, [[maybe_unused]] X& b) override
+    {
+    }
+
+    void apply(X& v, const X& d) override
+    {
+        for (std::size_t i = 0; i != diag_.size(); ++i) {
+            v[i] = d[i] / diag_[i];
+        }
+    }
+
+    void post([[maybe_unused]] X& x) override
+    {
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+private:
+    const std::vector<double>& diag_;
+};
+
+} // namespace ddm
+
+#endif // OPM_MATRIX_FREE_OPERATOR_HPP_INCLUDED
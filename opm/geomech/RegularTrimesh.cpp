@@ -28,12 +28,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <fstream>
 #include <functional>
 #include <iterator>
 #include <limits>
+#include <ostream>
 #include <set>
 #include <tuple>
 #include <utility>
@@ -42,8 +44,8 @@
 namespace
 {
 const bool DEBUG_DUMP_GRIDS = false;
-static int DEBUG_CURRENT_GRID_ITERATION_COUNT = 0; // @@
-static int DEBUG_GRID_COUNT = 0;
+static std::atomic<int> DEBUG_CURRENT_GRID_ITERATION_COUNT {0}; // @@
+static std::atomic<int> DEBUG_GRID_COUNT {0};
 
 std::array<Opm::EdgeRef, 3>
 cell2edges(const Opm::CellRef& cell)
@@ -1616,7 +1618,8 @@ expand_to_criterion(
     const double threshold,
     const std::vector<CellRef>& fixed_cells,
     const int target_cellcount,
-    const int cellcount_threshold)
+    const int cellcount_threshold,
+    std::ostream& os)
 {
     RegularTrimesh working_mesh = mesh; // make a working copy of the mesh;
     std::vector<RegularTrimesh> last_meshes; // keep track of meshes at each level before coarsening
@@ -1635,13 +1638,13 @@ expand_to_criterion(
     // the initial mesh
     const int max_cellcount = 2000; // maximum number of cells in the final mesh
 
-    auto fixed_on_level = [&fixed_cells](const int level) -> std::vector<CellRef> {
+    auto fixed_on_level = [&fixed_cells, &os](const int level) -> std::vector<CellRef> {
         if (level == 0) {
             for (const auto& cell : fixed_cells) {
-                std::cout << "{" << cell[0] << ", " << cell[1] << ", " << cell[2] << "} ";
+                os << "{" << cell[0] << ", " << cell[1] << ", " << cell[2] << "} ";
             }
 
-            std::cout << std::endl;
+            os << std::endl;
             return fixed_cells;
         } else {
             std::vector<CellRef> result;
@@ -1649,12 +1652,12 @@ expand_to_criterion(
                 result.push_back(RegularTrimesh::fine_to_coarse(cell, level));
             }
 
-            // dump vector result to std::cout
+            // dump vector result to os
             for (const auto& cell : result) {
-                std::cout << "{" << cell[0] << ", " << cell[1] << ", " << cell[2] << "} ";
+                os << "{" << cell[0] << ", " << cell[1] << ", " << cell[2] << "} ";
             }
 
-            std::cout << std::endl;
+            os << std::endl;
 
             return result;
         }
@@ -1669,10 +1672,10 @@ expand_to_criterion(
         ++cur_level;
     }
 
-    std::cout << "---------- Starting propagation at level: " << cur_level << " --------" << std::endl;
+    os << "---------- Starting propagation at level: " << cur_level << " --------" << std::endl;
     while (true) { // keep looping as long as grid need expansion
         if (DEBUG_DUMP_GRIDS) {
-            const std::string filename = "current_grid_" + std::to_string(DEBUG_GRID_COUNT) + "_"
+            const std::string filename = "current_grid_" + std::to_string(DEBUG_GRID_COUNT.load()) + "_"
                 + std::to_string(DEBUG_CURRENT_GRID_ITERATION_COUNT++);
 
             writeMeshToVTKDebug(working_mesh, filename.c_str(), 0, 1);
@@ -1709,7 +1712,7 @@ expand_to_criterion(
             working_mesh.removeSawtooths();
 
             roof = cur_level--;
-            std::cout << "** -------- Refining to level -------- " << cur_level << std::endl;
+            os << "** -------- Refining to level -------- " << cur_level << std::endl;
             iter_count = 0;
         } else if (iter_count >= max_iter && cur_level < roof - 1) {
             // expansion is going too slowly, move to coarser level
@@ -1721,7 +1724,7 @@ expand_to_criterion(
             working_mesh.removeSawtooths();
             ++cur_level;
 
-            std::cout << "** -------- Coarsening to level ------- " << cur_level << std::endl;
+            os << "** -------- Coarsening to level ------- " << cur_level << std::endl;
             iter_count = 0;
         } else {
             // expanding grid at current level
@@ -1731,7 +1734,7 @@ expand_to_criterion(
         }
     }
 
-    std::cout << " ** ---------- CONVERGED BOUNDARY MESH ---------- **" << std::endl;
+    os << " ** ---------- CONVERGED BOUNDARY MESH ---------- **" << std::endl;
 
     return {working_mesh, cur_level};
 }
@@ -281,8 +281,9 @@ std::tuple<RegularTrimesh, int> expand_to_criterion(
     double threshold,
     const std::vector<CellRef>& fixed_cells,
     const int target_cellcount, // target number of cells in final mesh
-    const int cellcount_threshold // target number of cells in initial mesh to expand
-                                  // (start level will be determined by this)
+    const int cellcount_threshold, // target number of cells in initial mesh to expand
+                                   // (start level will be determined by this)
+    std::ostream& os // progress output
 );
 
 } // namespace Opm
@@ -20,6 +20,8 @@
 #ifndef OPM_ECLPROBLEM_GEOMECH_MODEL_HH
 #define OPM_ECLPROBLEM_GEOMECH_MODEL_HH
 
+#include <opm/common/OpmLog/OpmLog.hpp>
+
 #include <opm/material/densead/Evaluation.hpp>
 #include <opm/material/densead/Math.hpp>
 
@@ -202,11 +204,34 @@ public:
                       << std::endl;
             fracturemodel_->updateReservoirAndWellProperties<TypeTag>(simulator_);
             fracturemodel_->solve<TypeTag>(simulator_);
+
+            if (include_fracture_contributions_) {
+                this->updateFractureFields();
+            }
         } else {
             std::cout << "Fracture model not initialized, not solving fractures" << std::endl;
         }
     }
 
+    // Fracture induced displacement, strain and stress at all cell centers.  They
+    // only change when the fractures are solved, so they are computed once here
+    // rather than in each per-cell query.
+    void updateFractureFields()
+    {
+        OPM_TIMEBLOCK(updateFractureFields);
+
+        const auto& gv = simulator_.vanguard().grid().leafGridView();
+
+        std::vector<Dune::FieldVector<double, 3>> centers(gv.size(0));
+        for (const auto& cell : elements(gv)) {
+            const auto center = cell.geometry().center();
+            const auto cellindex = simulator_.problem().elementMapper().index(cell);
+            centers[cellindex] = {center[0], center[1], center[2]};
+        }
+
+        fracturemodel_->fields(centers, fracture_disp_, fracture_strain_, fracture_stress_);
+    }
+
     void writeFractureSolution()
     {
         const auto& problem = simulator_.problem();
@@ -224,6 +249,27 @@ public:
         }
     }
 
+    // number of fracture solves of each kind (see "solver.reuse_tol") of all ranks
+    // so far, logged by rank 0.  Collective, called at the end of each report step.
+    void reportFractureSolveStatistics() const
+    {
+        if (!simulator_.problem().hasFractures() || !fracturemodel_) {
+            return;
+        }
+
+        const auto statistics = fracturemodel_->solveStatistics();
+        int counts[3] = {statistics.full, statistics.correction, statistics.skipped};
+        const auto& comm = simulator_.vanguard().grid().comm();
+        comm.sum(counts, 3);
+
+        if (comm.rank() == 0) {
+            std::ostringstream os;
+            os << "Fracture solves: " << counts[0] << " full, " << counts[1] << " corrected, "
+               << counts[2] << " skipped";
+            OpmLog::info(os.str());
+        }
+    }
+
     std::vector<RuntimePerforation> getExtraWellIndices(const std::string& wellname)
     {
         if (fracturemodel_) {
@@ -515,15 +561,8 @@ public:
     {
         auto disp = celldisplacement_[globalIdx];
 
-        if (include_fracture_contributions_ && with_fracture && (fracturemodel_ != nullptr)) {
-            for (const auto& elem : Dune::elements(simulator_.vanguard().grid().leafGridView())) {
-                const auto& center = elem.geometry().center();
-
-                const Dune::FieldVector<double, 3> obs {center[0], center[1], center[2]};
-
-                // check if this is correct stress
-                disp += fracturemodel_->disp(obs);
-            }
+        if (include_fracture_contributions_ && with_fracture && !fracture_disp_.empty()) {
+            disp += fracture_disp_[globalIdx];
         }
 
         return disp;
@@ -556,17 +595,11 @@ public:
     {
         auto strain = strain_[globalIdx];
 
-        if (include_fracture_contributions_ && with_fracture && (fracturemodel_ != nullptr)) {
-            for (const auto& elem : Dune::elements(simulator_.vanguard().grid().leafGridView())) {
-                const auto center = elem.geometry().center();
-                const Dune::FieldVector<double, 3> obs {center[0], center[1], center[2]};
-
-                // check if this is correct stress
-                strain += fracturemodel_->strain(obs);
-            }
+        if (include_fracture_contributions_ && with_fracture && !fracture_strain_.empty()) {
+            strain += fracture_strain_[globalIdx];
         }
 
-        return strain_[globalIdx];
+        return strain;
     }
 
     SymTensor stress(const std::size_t globalIdx, const bool with_fracture = false) const
@@ -579,14 +612,8 @@ public:
             effStress[i] += effPress;
         }
 
-        if (include_fracture_contributions_ && with_fracture && (fracturemodel_ != nullptr)) {
-            for (const auto& elem : Dune::elements(simulator_.vanguard().grid().leafGridView())) {
-                const auto center = elem.geometry().center();
-                const Dune::FieldVector<double, 3> obs {center[0], center[1], center[2]};
-
-                // check if this is correct stress
-                effStress += fracturemodel_->stress(obs);
-            }
+        if (include_fracture_contributions_ && with_fracture && !fracture_stress_.empty()) {
+            effStress += fracture_stress_[globalIdx];
         }
 
         return effStress;
@@ -681,6 +708,11 @@ private:
     Opm::Elasticity::VemElasticitySolver<Grid> elacticitysolver_;
 
     std::unique_ptr<FractureModel> fracturemodel_;
+
+    // fracture contributions at cell centers, see updateFractureFields()
+    std::vector<Dune::FieldVector<double, 3>> fracture_disp_;
+    std::vector<SymTensor> fracture_strain_;
+    std::vector<SymTensor> fracture_stress_;
 };
 
 } // namespace Opm
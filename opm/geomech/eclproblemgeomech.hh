@@ -500,6 +500,7 @@ public:
     {
         Parent::endEpisode();
         geomechModel_.writeFractureSolution();
+        geomechModel_.reportFractureSolveStatistics();
     }
 
     const EclGeoMechModel<TypeTag>& geoMechModel() const